@@ -0,0 +1,441 @@
+#include <benchmark/benchmark.h>
+#include <opencv2/opencv.hpp>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include "frame_packet.hpp"
+#include "logger.hpp"
+#include "metadata.hpp"
+#include "synthetic_source.hpp"
+
+// Микробенчмарки покадровых операций конвейера. Каждый бенчмарк
+// дополнительно сообщает число выделений памяти на операцию (allocs/op):
+// operator new во всех потоках процесса и буферы cv::Mat. Внутренние
+// выделения кодеков (malloc в libjpeg) не считаются.
+//
+// Регрессии: --baseline=<file> сравнивает allocs/op (и время при
+// --time_tolerance=<доля>) с сохранённым прогоном и завершается с ошибкой,
+// если что-то выросло или набор бенчмарков разошёлся с базовым;
+// --write_baseline=<file> сохраняет текущий прогон.
+
+// ---- Счётчик выделений памяти ----
+
+namespace {
+
+// Общий на все потоки: выделения потока-потребителя в BM_QueueHandoff тоже считаются
+std::atomic<std::uint64_t> allocationCount{0};
+
+void* countedAlloc(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// Буферы cv::Mat выделяются через cv::fastMalloc в обход operator new,
+// поэтому стандартный аллокатор OpenCV оборачивается счётчиком
+class CountingMatAllocator : public cv::MatAllocator {
+public:
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                           cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override {
+        if (!data) {
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(cv::UMatData* data, cv::AccessFlag accessFlags, cv::UMatUsageFlags usageFlags) const override {
+        return cv::Mat::getStdAllocator()->allocate(data, accessFlags, usageFlags);
+    }
+
+    void deallocate(cv::UMatData* data) const override {
+        cv::Mat::getStdAllocator()->deallocate(data);
+    }
+};
+
+// Счётчик общий, поэтому замер ведёт только поток 0 — между барьерами начала
+// и конца цикла он видит выделения всех потоков; kAvgIterations делит на сумму итераций
+class AllocationCounter {
+public:
+    explicit AllocationCounter(benchmark::State& state)
+        : state_(state), start_(allocationCount.load(std::memory_order_relaxed)) {}
+    ~AllocationCounter() {
+        if (state_.thread_index() == 0) {
+            state_.counters["allocs/op"] = benchmark::Counter(
+                static_cast<double>(allocationCount.load(std::memory_order_relaxed) - start_),
+                benchmark::Counter::kAvgIterations);
+        }
+    }
+
+private:
+    benchmark::State& state_;
+    std::uint64_t start_;
+};
+
+nlohmann::json sampleMetadata() {
+    return nlohmann::json{
+        {"frame_size", 123456},
+        {"timestamp", 1700000000000000},
+        {"frame_id", 42},
+        {"slice_index", 1},
+        {"slice_count", 4},
+        {"slice_y", 270},
+        {"slice_height", 270},
+        {"frame_width", 1920},
+        {"frame_height", 1080}
+    };
+}
+
+cv::Mat sampleFrame(int width, int height) {
+    SyntheticSource source(width, height, 1000.0, 0.5, 1);
+    cv::Mat frame;
+    source.read(frame);
+    return frame;
+}
+
+std::vector<unsigned char> samplePacket(size_t payloadSize) {
+    return buildFramePacket(sampleMetadata().dump(), std::vector<unsigned char>(payloadSize, 0x5a));
+}
+
+// ---- Метаданные ----
+
+void BM_MetaDataCreate(benchmark::State& state) {
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+        MetaData metaData;
+        metaData.create(nlohmann::json{
+            {"frame_size", 123456},
+            {"timestamp", 1700000000000000}
+            });
+        benchmark::DoNotOptimize(metaData.isValid());
+    }
+}
+BENCHMARK(BM_MetaDataCreate);
+
+void BM_MetaDataParse(benchmark::State& state) {
+    std::string text = sampleMetadata().dump();
+    std::vector<unsigned char> bytes(text.begin(), text.end());
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+        MetaData metaData;
+        metaData.parse(bytes);
+        benchmark::DoNotOptimize(metaData.isValid());
+    }
+}
+BENCHMARK(BM_MetaDataParse);
+
+void BM_JsonDump(benchmark::State& state) {
+    nlohmann::json metadata = sampleMetadata();
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+        std::string text = metadata.dump();
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+BENCHMARK(BM_JsonDump);
+
+// ---- Пакет кадра ----
+
+// Сборка пакета на отправителе (VideoSender::encodeAndSend)
+void BM_BuildFramePacket(benchmark::State& state) {
+    std::string metadata = sampleMetadata().dump();
+    std::vector<unsigned char> payload(static_cast<size_t>(state.range(0)), 0x5a);
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+        std::vector<unsigned char> packet = buildFramePacket(metadata, payload);
+        benchmark::DoNotOptimize(packet.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_BuildFramePacket)->Arg(16 << 10)->Arg(256 << 10)->Arg(1 << 20);
+
+// Поиск разделителя и разбор метаданных на получателе (VideoReceiver::decodePacket)
+void BM_ParseFramePacket(benchmark::State& state) {
+    std::vector<unsigned char> packet = samplePacket(static_cast<size_t>(state.range(0)));
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+        MetaData metaData;
+        const unsigned char* payload = nullptr;
+        size_t payloadSize = 0;
+        bool ok = parseFramePacket(packet.data(), packet.size(), metaData, payload, payloadSize);
+        benchmark::DoNotOptimize(ok);
+        benchmark::DoNotOptimize(payload);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(packet.size()));
+}
+BENCHMARK(BM_ParseFramePacket)->Arg(16 << 10)->Arg(256 << 10)->Arg(1 << 20);
+
+// ---- JPEG ----
+
+void jpegArgs(benchmark::internal::Benchmark* bench) {
+    for (int height : {360, 720, 1080}) {
+        for (int quality : {50, 90}) {
+            bench->Args({height, quality});
+        }
+    }
+}
+
+void BM_ImEncode(benchmark::State& state) {
+    auto height = static_cast<int>(state.range(0));
+    cv::Mat frame = sampleFrame(height * 16 / 9, height);
+    std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, static_cast<int>(state.range(1))};
+    std::vector<unsigned char> encoded;
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+        cv::imencode(".jpg", frame, encoded, params);
+        benchmark::DoNotOptimize(encoded.data());
+    }
+    state.counters["bytes/frame"] = static_cast<double>(encoded.size());
+}
+BENCHMARK(BM_ImEncode)->Apply(jpegArgs)->Unit(benchmark::kMillisecond);
+
+void BM_ImDecode(benchmark::State& state) {
+    auto height = static_cast<int>(state.range(0));
+    cv::Mat frame = sampleFrame(height * 16 / 9, height);
+    std::vector<unsigned char> encoded;
+    cv::imencode(".jpg", frame, encoded, {cv::IMWRITE_JPEG_QUALITY, static_cast<int>(state.range(1))});
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+        cv::Mat decoded = cv::imdecode(encoded, cv::IMREAD_COLOR);
+        benchmark::DoNotOptimize(decoded.data);
+    }
+}
+BENCHMARK(BM_ImDecode)->Apply(jpegArgs)->Unit(benchmark::kMillisecond);
+
+// ---- Logger ----
+
+void BM_LoggerLog(benchmark::State& state) {
+    std::string message = "Frame queue is full. Dropping frame.";
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+        Logger::getInstance().log(message);
+    }
+}
+BENCHMARK(BM_LoggerLog)->ThreadRange(1, 8)->UseRealTime();
+
+// ---- Очередь кадров ----
+
+// Та же схема, что и очереди кадров VideoSender/VideoReceiver: std::queue + mutex +
+// condition_variable. Пинг-понг между двумя потоками, время итерации — две передачи.
+class FrameHandoff {
+public:
+    void push(std::queue<std::shared_ptr<cv::Mat>>& queue, std::shared_ptr<cv::Mat> frame) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue.push(std::move(frame));
+        }
+        condVar_.notify_all();
+    }
+
+    std::shared_ptr<cv::Mat> pop(std::queue<std::shared_ptr<cv::Mat>>& queue) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condVar_.wait(lock, [&]() { return !queue.empty() || stop_; });
+        if (queue.empty()) {
+            return nullptr;
+        }
+        auto frame = std::move(queue.front());
+        queue.pop();
+        return frame;
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condVar_.notify_all();
+    }
+
+    std::queue<std::shared_ptr<cv::Mat>> forward;
+    std::queue<std::shared_ptr<cv::Mat>> backward;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condVar_;
+    bool stop_ = false;
+};
+
+void BM_QueueHandoff(benchmark::State& state) {
+    FrameHandoff handoff;
+    std::thread consumer([&handoff]() {
+        while (auto frame = handoff.pop(handoff.forward)) {
+            handoff.push(handoff.backward, std::move(frame));
+        }
+    });
+
+    auto frame = std::make_shared<cv::Mat>();
+    AllocationCounter allocations(state);
+    for (auto _ : state) {
+        handoff.push(handoff.forward, frame);
+        frame = handoff.pop(handoff.backward);
+    }
+
+    handoff.stop();
+    consumer.join();
+}
+BENCHMARK(BM_QueueHandoff)->UseRealTime();
+
+// Поглощает вывод Logger в std::cout, чтобы он не смешивался с отчётом
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int ch) override { return ch; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// ---- Сравнение с базовым прогоном ----
+
+// Консольный отчёт, который заодно собирает allocs/op и время каждого прогона
+class CollectingReporter : public benchmark::ConsoleReporter {
+public:
+    void ReportRuns(const std::vector<Run>& runs) override {
+        benchmark::ConsoleReporter::ReportRuns(runs);
+        for (const Run& run : runs) {
+            auto allocs = run.counters.find("allocs/op");
+            if (run.run_type != Run::RT_Iteration || allocs == run.counters.end()) {
+                continue;
+            }
+            double realTimeNs = run.GetAdjustedRealTime() * 1e9 / benchmark::GetTimeUnitMultiplier(run.time_unit);
+            results[run.benchmark_name()] = nlohmann::json{
+                {"allocs_per_op", allocs->second.value},
+                {"real_time_ns", realTimeNs}
+            };
+        }
+    }
+
+    nlohmann::json results = nlohmann::json::object();
+};
+
+// Выделения детерминированы, поэтому допуск — полвыделения на операцию.
+// Время сравнивается, только если задан допуск: базовый прогон должен быть с той же машины.
+// Бенчмарк без записи в базовом прогоне — тоже ошибка, иначе он не проверяется никогда;
+// запись без бенчмарка допустима только при --benchmark_filter.
+bool compareWithBaseline(const nlohmann::json& results, const nlohmann::json& baseline, double timeTolerance,
+                         bool filtered, std::ostream& out) {
+    constexpr double allocationTolerance = 0.5;
+    bool ok = true;
+    for (const auto& item : baseline.items()) {
+        if (!filtered && !results.contains(item.key())) {
+            out << "MISSING " << item.key() << ": in baseline but not in this run\n";
+            ok = false;
+        }
+    }
+    for (const auto& item : results.items()) {
+        if (!baseline.contains(item.key())) {
+            out << "MISSING " << item.key() << ": not in baseline, regenerate it with --write_baseline\n";
+            ok = false;
+            continue;
+        }
+        const nlohmann::json& expected = baseline.at(item.key());
+        double allocs = item.value().at("allocs_per_op").get<double>();
+        double expectedAllocs = expected.value("allocs_per_op", allocs);
+        if (allocs > expectedAllocs + allocationTolerance) {
+            out << "REGRESSION " << item.key() << ": allocs/op " << allocs << " > baseline " << expectedAllocs << "\n";
+            ok = false;
+        }
+        double time = item.value().at("real_time_ns").get<double>();
+        double expectedTime = expected.value("real_time_ns", 0.0);
+        if (timeTolerance > 0.0 && expectedTime > 0.0 && time > expectedTime * (1.0 + timeTolerance)) {
+            out << "REGRESSION " << item.key() << ": " << time << " ns > baseline " << expectedTime << " ns\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Забирает из argv собственный флаг вида --name=value
+bool takeFlag(int& argc, char** argv, const char* name, std::string& value) {
+    std::string prefix = std::string("--") + name + "=";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], prefix.c_str(), prefix.size()) == 0) {
+            value = argv[i] + prefix.size();
+            for (int j = i; j + 1 < argc; ++j) {
+                argv[j] = argv[j + 1];
+            }
+            --argc;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string baselinePath;
+    std::string writeBaselinePath;
+    std::string timeToleranceText;
+    bool filtered = false;
+    for (int i = 1; i < argc; ++i) {
+        filtered = filtered || std::strncmp(argv[i], "--benchmark_filter", 18) == 0;
+    }
+    takeFlag(argc, argv, "baseline", baselinePath);
+    takeFlag(argc, argv, "write_baseline", writeBaselinePath);
+    takeFlag(argc, argv, "time_tolerance", timeToleranceText);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    nlohmann::json baseline;
+    if (!baselinePath.empty()) {
+        std::ifstream baselineFile(baselinePath);
+        if (!baselineFile) {
+            std::cerr << "Cannot open baseline " << baselinePath
+                      << " (create it with --write_baseline or the microBenchBaseline target)" << std::endl;
+            return 1;
+        }
+        baselineFile >> baseline;
+    }
+
+    static CountingMatAllocator matAllocator;
+    cv::Mat::setDefaultAllocator(&matAllocator);
+
+    // Отчёт пишется в исходный буфер stdout, всё остальное в std::cout — в никуда.
+    // Машиночитаемый результат: --benchmark_out=<file> --benchmark_out_format=json
+    std::ostream reportStream(std::cout.rdbuf());
+    NullBuffer nullBuffer;
+    std::streambuf* original = std::cout.rdbuf(&nullBuffer);
+
+    CollectingReporter reporter;
+    reporter.SetOutputStream(&reportStream);
+    reporter.SetErrorStream(&std::cerr);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+
+    std::cout.rdbuf(original);
+    benchmark::Shutdown();
+
+    if (!writeBaselinePath.empty()) {
+        std::ofstream(writeBaselinePath) << reporter.results.dump(2) << std::endl;
+    }
+    if (!baselinePath.empty() &&
+        !compareWithBaseline(reporter.results, baseline,
+                             timeToleranceText.empty() ? 0.0 : std::stod(timeToleranceText), filtered, std::cerr)) {
+        return 1;
+    }
+    return 0;
+}
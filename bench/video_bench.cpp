@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <yaml-cpp/yaml.h>
+#include "video_sender.hpp"
+#include "video_receiver.hpp"
+#include "synthetic_source.hpp"
+
+#ifdef __unix__
+#include <sys/resource.h>
+#endif
+
+// Сквозной бенчмарк конвейера: отправитель и получатель в одном процессе через loopback,
+// кадры от синтетического генератора, прогон по матрице параметров.
+
+namespace {
+
+struct BenchSettings {
+    int width = 640;
+    int height = 360;
+    double fps = 30.0;
+    double complexity = 0.5;
+    double durationSec = 5.0;
+    unsigned short basePort = 23450;
+};
+
+struct BenchCase {
+    std::string protocol;
+    size_t queueSize;
+    int jpegQuality;
+    unsigned threads;
+};
+
+std::int64_t currentTimeUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Процессорное время всего процесса (все потоки конвейера), секунды
+double processCpuSeconds() {
+#ifdef __unix__
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#else
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    auto index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+ProtocolType parseProtocol(const std::string& name) {
+    if (name == "udp") {
+        return ProtocolType::UDP;
+    }
+    if (name == "shm") {
+        return ProtocolType::SHM;
+    }
+    return ProtocolType::TCP;
+}
+
+template <typename T>
+std::vector<T> readList(const YAML::Node& node, std::vector<T> defaults) {
+    return node ? node.as<std::vector<T>>() : defaults;
+}
+
+nlohmann::json runCase(const BenchCase& benchCase, const BenchSettings& settings, unsigned short port) {
+    ProtocolType protocol = parseProtocol(benchCase.protocol);
+    auto frameLimit = static_cast<size_t>(settings.fps * settings.durationSec);
+    SyntheticSource source(settings.width, settings.height, settings.fps, settings.complexity, frameLimit);
+
+    ThreadingConfig quiet;
+    quiet.statsIntervalSec = 0;
+
+    std::mutex resultMutex;
+    std::vector<double> latenciesMs;
+    latenciesMs.reserve(frameLimit);
+    size_t receivedBytes = 0;
+    auto lastFrameTime = std::chrono::steady_clock::now();
+
+    VideoReceiver receiver(protocol, port, static_cast<unsigned short>(settings.fps),
+                           static_cast<unsigned short>(settings.width), static_cast<unsigned short>(settings.height));
+    receiver.setThreadingConfig(quiet);
+    receiver.setSliceThreads(benchCase.threads);
+    receiver.setFrameSink([&](const cv::Mat&, const VideoReceiver::FrameInfo& info) {
+        double latencyMs = static_cast<double>(currentTimeUs() - info.timestampUs) / 1000.0;
+        std::lock_guard<std::mutex> lock(resultMutex);
+        latenciesMs.push_back(latencyMs);
+        receivedBytes += info.encodedBytes;
+        lastFrameTime = std::chrono::steady_clock::now();
+    });
+    std::thread receiverThread(&VideoReceiver::start, &receiver);
+
+    // Замер начинается с первого кадра, после паузы на подключение (accept, открытие shm)
+    bool warmedUp = false;
+    auto wallStart = std::chrono::steady_clock::now();
+    double cpuStart = 0.0;
+
+    try {
+        VideoSender sender("127.0.0.1", port, 0, protocol);
+        sender.setThreadingConfig(quiet);
+        sender.setJpegQuality(benchCase.jpegQuality);
+        sender.setMaxQueueSize(benchCase.queueSize);
+        sender.setSlicing(benchCase.threads, benchCase.threads);
+        sender.setFrameSource([&](cv::Mat& frame) {
+            if (!warmedUp) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                wallStart = std::chrono::steady_clock::now();
+                cpuStart = processCpuSeconds();
+                warmedUp = true;
+            }
+            return source.read(frame);
+        });
+        sender.start();
+
+        // Дожидаемся хвоста: всё доставлено или секунда тишины
+        while (true) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (latenciesMs.size() >= source.framesProduced() ||
+                std::chrono::steady_clock::now() - std::max(lastFrameTime, wallStart) > std::chrono::seconds(1)) {
+                break;
+            }
+        }
+    } catch (...) {
+        // Ошибка подключения или shm_open: получатель ещё ждёт в accept/receive,
+        // и его поток нужно дождаться до раскрутки стека, иначе std::terminate
+        receiver.stop();
+        receiverThread.join();
+        throw;
+    }
+    // stop() прерывает и блокирующий receive()
+    receiver.stop();
+    receiverThread.join();
+
+    double cpuSeconds = processCpuSeconds() - cpuStart;
+    std::lock_guard<std::mutex> lock(resultMutex);
+    double wallSeconds = std::chrono::duration<double>(std::max(lastFrameTime, wallStart) - wallStart).count();
+    size_t produced = source.framesProduced();
+    size_t received = latenciesMs.size();
+    std::sort(latenciesMs.begin(), latenciesMs.end());
+
+    return nlohmann::json{
+        {"protocol", benchCase.protocol},
+        {"queue_size", benchCase.queueSize},
+        {"jpeg_quality", benchCase.jpegQuality},
+        {"threads", benchCase.threads},
+        {"width", settings.width},
+        {"height", settings.height},
+        {"target_fps", settings.fps},
+        {"complexity", settings.complexity},
+        {"frames_sent", produced},
+        {"frames_received", received},
+        {"drop_rate", produced > 0 ? 1.0 - static_cast<double>(received) / static_cast<double>(produced) : 0.0},
+        {"fps", wallSeconds > 0.0 ? static_cast<double>(received) / wallSeconds : 0.0},
+        {"throughput_mbps", wallSeconds > 0.0 ? static_cast<double>(receivedBytes) * 8.0 / wallSeconds / 1e6 : 0.0},
+        {"cpu_ms_per_frame", received > 0 ? cpuSeconds * 1000.0 / static_cast<double>(received) : 0.0},
+        {"latency_ms_p50", percentile(latenciesMs, 0.50)},
+        {"latency_ms_p99", percentile(latenciesMs, 0.99)},
+        {"latency_ms_p999", percentile(latenciesMs, 0.999)}
+    };
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string config_path = argc > 1 ? argv[1] : std::string(CONFIG_DIR) + "/benchConfigure.yaml";
+        YAML::Node config = YAML::LoadFile(config_path);
+
+        BenchSettings settings;
+        if (config["width"]) settings.width = config["width"].as<int>();
+        if (config["height"]) settings.height = config["height"].as<int>();
+        if (config["fps"]) settings.fps = config["fps"].as<double>();
+        if (config["complexity"]) settings.complexity = config["complexity"].as<double>();
+        if (config["durationSec"]) settings.durationSec = config["durationSec"].as<double>();
+        if (config["basePort"]) settings.basePort = config["basePort"].as<unsigned short>();
+        std::string output = config["output"] ? config["output"].as<std::string>() : "bench_results.json";
+
+        auto protocols = readList<std::string>(config["protocols"], {"udp", "tcp"});
+        auto queueSizes = readList<size_t>(config["queueSizes"], {10});
+        auto jpegQualities = readList<int>(config["jpegQualities"], {90});
+        auto threadCounts = readList<unsigned>(config["threads"], {1});
+
+        nlohmann::json results = nlohmann::json::array();
+        unsigned short port = settings.basePort;
+        for (const auto& protocol : protocols) {
+            for (size_t queueSize : queueSizes) {
+                for (int quality : jpegQualities) {
+                    for (unsigned threads : threadCounts) {
+                        BenchCase benchCase{protocol, queueSize, quality, threads};
+                        // Отдельный порт на прогон, чтобы не упираться в TIME_WAIT
+                        nlohmann::json result = runCase(benchCase, settings, port++);
+                        results.push_back(result);
+
+                        std::cout << "BENCH " << result.dump() << std::endl;
+                        // Промежуточное сохранение: результаты не теряются при падении следующего прогона
+                        std::ofstream(output) << results.dump(2) << std::endl;
+                    }
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
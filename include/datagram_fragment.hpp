@@ -0,0 +1,49 @@
+#ifndef DATAGRAM_FRAGMENT_HPP
+#define DATAGRAM_FRAGMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Деление пакета кадра на датаграммы не больше MTU. Одну большую датаграмму
+// ядро режет на IP-фрагменты и отдаёт пачкой, а отдельные датаграммы
+// отправитель может разнести во времени.
+//
+// Заголовок фрагмента (20 байт, сетевой порядок): метка, номер пакета,
+// размер пакета, размер части, индекс и число фрагментов. Первый байт метки
+// 0xFF не встречается в начале пакета кадра, который начинается с JSON.
+
+constexpr size_t kFragmentHeaderSize = 20;
+// MTU Ethernet 1500 минус заголовки IPv4 и UDP
+constexpr size_t kFragmentDatagramSize = 1472;
+// Наибольшая полезная нагрузка UDP поверх IPv4; пакет крупнее делится всегда
+constexpr size_t kMaxDatagramSize = 65507;
+
+size_t fragmentCount(size_t packetSize, size_t datagramSize);
+
+// Записывает в datagram фрагмент index пакета packet
+void writeFragment(std::vector<unsigned char>& datagram, const std::vector<unsigned char>& packet,
+                   size_t datagramSize, std::uint32_t packetId, size_t index);
+
+// Сборка пакетов из фрагментов одного отправителя. Пакет с потерянным
+// фрагментом отбрасывается целиком, как потерянная датаграмма.
+class FragmentAssembler {
+public:
+    // true, если packet содержит готовый пакет. Датаграмма без заголовка
+    // фрагмента возвращается как есть.
+    bool add(std::vector<unsigned char>&& datagram, std::vector<unsigned char>& packet);
+
+private:
+    void reset(std::uint32_t packetId, size_t packetSize, size_t chunkSize, size_t count);
+
+    bool active_ = false;
+    std::uint32_t packetId_ = 0;
+    bool completed_ = false;              // Последний собранный пакет; его повторы игнорируются
+    std::uint32_t completedId_ = 0;
+    size_t chunkSize_ = 0;
+    size_t missing_ = 0;
+    std::vector<unsigned char> packet_;
+    std::vector<bool> received_;
+};
+
+#endif // DATAGRAM_FRAGMENT_HPP
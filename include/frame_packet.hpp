@@ -0,0 +1,33 @@
+#ifndef FRAME_PACKET_HPP
+#define FRAME_PACKET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "metadata.hpp"
+
+// Формат пакета кадра: JSON-метаданные, нулевой байт-разделитель, сжатые данные.
+
+// Собирает пакет за одно выделение памяти
+std::vector<unsigned char> buildFramePacket(const std::string& metadata, const std::vector<unsigned char>& payload);
+
+// Размер пакета и его запись в готовый буфер (например, слот shared memory) без промежуточной копии
+size_t framePacketSize(const std::string& metadata, const std::vector<unsigned char>& payload);
+void writeFramePacket(unsigned char* destination, const std::string& metadata, const std::vector<unsigned char>& payload);
+
+// Разбирает пакет без копирования полезной нагрузки: payload указывает внутрь data.
+// false — нет разделителя, метаданные некорректны или данные пусты.
+bool parseFramePacket(const unsigned char* data, size_t size, MetaData& metaData,
+                      const unsigned char*& payload, size_t& payloadSize);
+
+// В потоковом транспорте (TCP) границ сообщений нет, поэтому перед пакетом
+// идёт его длина: 4 байта в сетевом порядке
+constexpr size_t kStreamLengthSize = 4;
+// Больше не бывает: защита от рассинхронизации потока
+constexpr size_t kMaxStreamPacketSize = 64 * 1024 * 1024;
+
+void writeStreamLength(unsigned char* destination, size_t size);
+size_t readStreamLength(const unsigned char* source);
+
+#endif // FRAME_PACKET_HPP
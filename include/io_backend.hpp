@@ -0,0 +1,13 @@
+#ifndef IO_BACKEND_HPP
+#define IO_BACKEND_HPP
+
+#include <string>
+
+// Сетевой бэкенд для TCP/UDP транспортов
+enum class IOBackend { Asio, IoUring };
+
+// Выбор бэкенда при старте: "io_uring" используется, только если он собран
+// и поддерживается ядром, иначе — откат на Asio
+IOBackend selectIOBackend(const std::string& requested);
+
+#endif // IO_BACKEND_HPP
@@ -0,0 +1,42 @@
+#ifndef PACER_HPP
+#define PACER_HPP
+
+#include <yaml-cpp/yaml.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Настройки сглаживания отправки UDP (секция pacing в YAML)
+struct PacingConfig {
+    bool enabled = false;
+    bool frameMode = true;            // true — растягивать кадр на интервал кадра, false — ограничение битрейта
+    std::uint64_t rateBps = 0;        // Ограничение скорости, бит/с (0 — без ограничения)
+    std::size_t burstBytes = 65536;   // Размер корзины токенов
+    bool kernelPacing = true;         // SO_MAX_PACING_RATE, если на выходном интерфейсе подтверждён qdisc fq
+    unsigned targetFPS = 30;
+};
+
+PacingConfig loadPacingConfig(const YAML::Node& node, unsigned targetFPS);
+
+// Корзина токенов: acquire() блокирует отправку, пока не накопится нужное число байт
+class TokenBucketPacer {
+public:
+    TokenBucketPacer(double bytesPerSecond, std::size_t burstBytes);
+
+    // Возвращает задержку, добавленную к отправке
+    std::chrono::nanoseconds acquire(std::size_t bytes);
+
+    // Смена скорости без сброса накопленных токенов
+    void setRate(double bytesPerSecond);
+
+private:
+    void refill(std::chrono::steady_clock::time_point now);
+
+    double rate_;     // байт/с
+    double burst_;
+    double tokens_;
+    std::chrono::steady_clock::time_point last_;
+};
+
+#endif // PACER_HPP
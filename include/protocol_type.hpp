@@ -0,0 +1,7 @@
+#ifndef PROTOCOL_TYPE_HPP
+#define PROTOCOL_TYPE_HPP
+
+// Перечисления для протоколов передачи
+enum class ProtocolType { TCP, UDP, SHM };
+
+#endif // PROTOCOL_TYPE_HPP
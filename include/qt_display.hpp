@@ -0,0 +1,45 @@
+#ifndef QT_DISPLAY_HPP
+#define QT_DISPLAY_HPP
+
+#include <QImage>
+#include <QWidget>
+#include <opencv2/core.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Плитка с видеопотоком. Кадры приходят из потока декодирования,
+// отрисовка идёт в потоке Qt; промежуточные кадры при отставании UI отбрасываются.
+class VideoTile : public QWidget {
+public:
+    explicit VideoTile(QWidget* parent = nullptr);
+
+    // Потокобезопасно; кадр не копируется — сохраняется ссылка на буфер cv::Mat
+    void submitFrame(const cv::Mat& frame);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    std::mutex frameMutex_;
+    cv::Mat pending_;    // Задний буфер: последний декодированный кадр
+    cv::Mat current_;    // Передний буфер: держит данные, на которые ссылается image_
+    QImage image_;
+    std::atomic<bool> updateQueued_{false};
+};
+
+// Окно-мозаика из нескольких потоков
+class MosaicWindow : public QWidget {
+public:
+    MosaicWindow(size_t tileCount, int videoWidth, int videoHeight);
+
+    VideoTile* tile(size_t index) const;
+
+protected:
+    void keyPressEvent(QKeyEvent* event) override;
+
+private:
+    std::vector<VideoTile*> tiles_;
+};
+
+#endif // QT_DISPLAY_HPP
@@ -7,6 +7,9 @@ public:
 
     virtual void start() = 0;
     virtual std::vector<unsigned char> receive() = 0;
+
+    // Прерывает блокирующие start() и receive() из другого потока
+    virtual void stop() {}
 };
 
 #endif // RECEIVER_HPP
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include "frame_packet.hpp"
 
 class Sender {
 public:
@@ -12,6 +13,16 @@ public:
     virtual void start() = 0;
 
     virtual void send(const std::vector<unsigned char>& data) = 0;
+
+    // Отправка кадра из метаданных и сжатых данных. По умолчанию пакет собирается
+    // целиком; транспорт может записать части прямо в свой буфер.
+    virtual void sendFrame(const std::string& metadata, const std::vector<unsigned char>& payload) {
+        send(buildFramePacket(metadata, payload));
+    }
+
+    // Вызывается после каждого кадра: транспорт собирает результаты отправки
+    // или готовится к следующему кадру
+    virtual void flush() {}
 };
 
 #endif // SENDER_HPP
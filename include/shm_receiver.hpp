@@ -0,0 +1,40 @@
+#ifndef SHM_RECEIVER_HPP
+#define SHM_RECEIVER_HPP
+
+#include "receiver.hpp"
+#include "shm_ring.hpp"
+
+class SHMReceiver : public Receiver {
+public:
+    explicit SHMReceiver(unsigned short port);
+    void start() override;
+
+    // Копирует кадр из слота; пустой вектор по таймауту ожидания
+    std::vector<unsigned char> receive() override;
+    // Ожидание в acquire() и так ограничено таймаутом; stop прерывает ожидание сегмента в start()
+    void stop() override;
+
+    // Чтение без копирования: указатель на данные прямо в слоте.
+    // После обработки нужно вызвать release(); false означает, что слот
+    // был перезаписан во время чтения и данные недействительны.
+    const unsigned char* acquire(size_t& size);
+    bool release();
+
+private:
+    // Подключение к сегменту; false, если писатель его ещё не создал
+    bool attach();
+
+    std::string name_;
+    ShmRing ring_;
+    std::uint64_t cursor_;
+    std::uint64_t acquiredSeq_;
+    std::uint64_t overruns_;
+    unsigned idleWaits_;                  // Таймауты ожидания подряд
+    std::atomic<bool> stopping_{false};
+
+    static constexpr int waitTimeoutMs_ = 100;
+    // Через столько пустых ожиданий проверяем, не пересоздан ли сегмент
+    static constexpr unsigned staleCheckWaits_ = 10;
+};
+
+#endif // SHM_RECEIVER_HPP
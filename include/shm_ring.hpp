@@ -0,0 +1,73 @@
+#ifndef SHM_RING_HPP
+#define SHM_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+// Кольцевой буфер кадров в POSIX shared memory.
+// Один писатель публикует кадры в слоты, читатели держат собственные курсоры.
+// Слот защищён счётчиком seq (seqlock): 2n+1 — идёт запись кадра n, 2n+2 — кадр n готов.
+struct ShmRingHeader {
+    std::atomic<std::uint32_t> magic;     // Пишется последним при инициализации
+    std::uint32_t slotCount;
+    std::uint64_t slotSize;
+    std::atomic<std::uint64_t> head;      // Количество опубликованных кадров
+    std::atomic<std::uint32_t> notify;    // Слово futex, увеличивается на каждый кадр
+    std::atomic<std::uint32_t> waiters;   // Число читателей, спящих на futex
+};
+
+struct ShmSlotHeader {
+    std::atomic<std::uint64_t> seq;
+    std::uint64_t size;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared memory requires lock-free atomics");
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shared memory requires lock-free atomics");
+
+class ShmRing {
+public:
+    static constexpr std::uint32_t kMagic = 0x56534d52; // "VSMR"
+    static constexpr std::uint32_t kDefaultSlotCount = 8;
+    static constexpr std::uint64_t kDefaultSlotSize = 4 * 1024 * 1024;
+
+    // Имя сегмента, общее для отправителя и получателя на одном порту
+    static std::string nameForPort(unsigned short port);
+
+    ShmRing();
+    ~ShmRing();
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    // Создание нового сегмента (писатель). Бросает std::runtime_error при ошибке.
+    void create(const std::string& name, std::uint32_t slotCount, std::uint64_t slotSize);
+    // Подключение к существующему сегменту (читатель). Возвращает false, если сегмент ещё не готов.
+    bool open(const std::string& name);
+
+    bool isMapped() const;
+    ShmRingHeader* header() const;
+    ShmSlotHeader* slot(std::uint64_t index) const;
+    unsigned char* slotData(std::uint64_t index) const;
+
+    // Ожидание изменения слова notify; false по таймауту
+    bool wait(std::uint32_t expected, int timeoutMs) const;
+    void wakeAll() const;
+
+    // false, если под именем сегмента теперь другой объект (писатель перезапущен)
+    // или сегмент удалён; отображённая память тогда больше не обновляется
+    bool isCurrent() const;
+
+private:
+    void unmap();
+
+    std::string name_;
+    bool owner_;
+    void* base_;
+    std::size_t mappedSize_;
+    dev_t device_;                        // Идентичность отображённого объекта
+    ino_t inode_;
+};
+
+#endif // SHM_RING_HPP
@@ -0,0 +1,28 @@
+#ifndef SHM_SENDER_HPP
+#define SHM_SENDER_HPP
+
+#include "sender.hpp"
+#include "shm_ring.hpp"
+
+class SHMSender : public Sender {
+public:
+    explicit SHMSender(unsigned short port,
+                       std::uint32_t slotCount = ShmRing::kDefaultSlotCount,
+                       std::uint64_t slotSize = ShmRing::kDefaultSlotSize);
+    void start() override;
+    void send(const std::vector<unsigned char>& data) override;
+    // Метаданные и данные кадра пишутся прямо в слот, без сборки пакета в куче
+    void sendFrame(const std::string& metadata, const std::vector<unsigned char>& payload) override;
+
+private:
+    // Публикация слота: fill записывает size байт по переданному адресу
+    template <typename Fill>
+    void publish(size_t size, Fill&& fill);
+
+    std::string name_;
+    std::uint32_t slotCount_;
+    std::uint64_t slotSize_;
+    ShmRing ring_;
+};
+
+#endif // SHM_SENDER_HPP
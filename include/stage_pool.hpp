@@ -0,0 +1,38 @@
+#ifndef STAGE_POOL_HPP
+#define STAGE_POOL_HPP
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "thread_config.hpp"
+
+// Пул потоков одной стадии конвейера (кодирование или декодирование полос).
+// Задачи исполняет boost::asio::thread_pool, а потоки создаёт сам пул и
+// подключает через attach(), чтобы каждый прошёл через ThreadScope:
+// имя, привязка к ядрам, приоритет и учёт CPU-времени.
+class StagePool {
+public:
+    // threads = 0 — по числу ядер
+    StagePool(ThreadStats& stats, const std::string& stage, const ThreadSettings& settings, unsigned threads);
+    // Задачи, которые ещё не начали выполняться, отбрасываются
+    ~StagePool();
+    StagePool(const StagePool&) = delete;
+    StagePool& operator=(const StagePool&) = delete;
+
+    // Исключение, вышедшее из задачи, завершает процесс (так устроен thread_pool)
+    template <typename Task>
+    void post(Task&& task) {
+        boost::asio::post(pool_, std::forward<Task>(task));
+    }
+
+    unsigned size() const;
+
+private:
+    boost::asio::thread_pool pool_{0};
+    std::vector<std::thread> threads_;
+};
+
+#endif // STAGE_POOL_HPP
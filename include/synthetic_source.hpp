@@ -0,0 +1,32 @@
+#ifndef SYNTHETIC_SOURCE_HPP
+#define SYNTHETIC_SOURCE_HPP
+
+#include <opencv2/core.hpp>
+#include <chrono>
+#include <cstddef>
+
+// Генератор тестовых кадров вместо камеры: движущийся градиент, блок и шум.
+// complexity от 0 (гладкое изображение, хорошо сжимается) до 1 (шум на весь кадр).
+class SyntheticSource {
+public:
+    SyntheticSource(int width, int height, double fps, double complexity, size_t frameLimit = 0);
+
+    // Выдаёт следующий кадр в темпе fps; false, когда достигнут frameLimit
+    bool read(cv::Mat& frame);
+
+    size_t framesProduced() const;
+
+private:
+    int width_;
+    int height_;
+    size_t frameLimit_;
+    size_t frameIndex_ = 0;
+    std::chrono::steady_clock::duration period_;
+    std::chrono::steady_clock::time_point next_;
+    bool started_ = false;
+
+    cv::Mat gradient_;   // Горизонтально периодический градиент шириной 2 * width
+    cv::Mat noise_;      // Заранее сгенерированный шум шириной 2 * width
+};
+
+#endif // SYNTHETIC_SOURCE_HPP
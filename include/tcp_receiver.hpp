@@ -3,6 +3,7 @@
 
 #include "receiver.hpp"
 #include <boost/asio.hpp>
+#include <atomic>
 
 using boost::asio::ip::tcp;
 
@@ -11,12 +12,14 @@ public:
     explicit TCPReceiver(unsigned short port);
     void start() override;
     std::vector<unsigned char> receive() override;
+    void stop() override;
 
 private:
     boost::asio::io_context ioContext_;
     tcp::acceptor acceptor_;
     tcp::socket socket_;
     bool isConnected_;
+    std::atomic<bool> stopping_{false};
 };
 
 #endif // TCP_RECEIVER_HPP
@@ -0,0 +1,71 @@
+#ifndef THREAD_CONFIG_HPP
+#define THREAD_CONFIG_HPP
+
+#include <yaml-cpp/yaml.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <time.h>
+#endif
+
+// Настройки размещения одного потока конвейера
+struct ThreadSettings {
+    std::vector<int> cpus;   // Маска привязки к ядрам; пусто — без привязки
+    int priority = 0;        // > 0 — SCHED_FIFO с этим приоритетом
+    bool numaLocal = false;  // Привязать память потока (буферы кадров) к NUMA-узлам cpus
+};
+
+// Секция threading из YAML: настройки по стадиям (capture, send, receive, display, encode, decode)
+struct ThreadingConfig {
+    std::map<std::string, ThreadSettings> stages;
+    unsigned statsIntervalSec = 5;  // 0 — только итоговый отчёт
+
+    const ThreadSettings& get(const std::string& stage) const;
+};
+
+ThreadingConfig loadThreadingConfig(const YAML::Node& node);
+
+// Учёт процессорного времени потоков конвейера
+class ThreadStats {
+public:
+    void report();
+    // Периодический отчёт, пока не выставлен stop
+    void runReporter(const std::atomic<bool>& stop, std::chrono::seconds interval);
+
+private:
+    friend class ThreadScope;
+
+    struct Entry {
+        std::string name;
+        std::chrono::nanoseconds cpuTime{0};
+        bool alive = true;
+#ifdef __linux__
+        clockid_t clock{};
+#endif
+    };
+
+    size_t add(const std::string& name);
+    void finish(size_t index);
+
+    std::mutex mutex_;
+    std::vector<Entry> entries_;
+};
+
+// RAII-обёртка для тела потока: имя, привязка, приоритет и учёт CPU-времени
+class ThreadScope {
+public:
+    ThreadScope(ThreadStats& stats, const std::string& name, const ThreadSettings& settings);
+    ~ThreadScope();
+    ThreadScope(const ThreadScope&) = delete;
+    ThreadScope& operator=(const ThreadScope&) = delete;
+
+private:
+    ThreadStats& stats_;
+    size_t index_;
+};
+
+#endif // THREAD_CONFIG_HPP
@@ -2,6 +2,7 @@
 #define UDP_RECEIVER_HPP
 
 #include "receiver.hpp"
+#include "datagram_fragment.hpp"
 #include <boost/asio.hpp>
 
 using boost::asio::ip::udp;
@@ -12,11 +13,13 @@ public:
     void start() override;
 
     std::vector<unsigned char> receive() override;
+    void stop() override;
 
 private:
     boost::asio::io_context ioContext_;
     udp::socket socket_;
     udp::endpoint senderEndpoint_;
+    FragmentAssembler assembler_;
 };
 
 #endif // UDP_RECEIVER_HPP
@@ -2,7 +2,10 @@
 #define UDP_SENDER_HPP
 
 #include "sender.hpp"
+#include "pacer.hpp"
+#include "datagram_fragment.hpp"
 #include <boost/asio.hpp>
+#include <memory>
 
 using boost::asio::ip::udp;
 
@@ -11,11 +14,39 @@ public:
     UDPSender(const std::string& address, unsigned short port);
     void start() override;
     void send(const std::vector<unsigned char>& data) override;
+    // Граница кадра: в режиме кадра по его размеру выбирается скорость следующего
+    void flush() override;
+
+    // Сглаживание отправки: SO_MAX_PACING_RATE (fq) или корзина токенов в пространстве пользователя
+    void setPacing(const PacingConfig& config);
 
 private:
+    void sendDatagram(const std::vector<unsigned char>& data);
+    bool setKernelPacingRate(std::uint64_t bytesPerSecond);
+    // Скорость для режима кадра: кадр растягивается на ~80% интервала кадра
+    std::uint64_t frameRate(std::uint64_t frameBytes) const;
+    void reportPacing(std::chrono::nanoseconds delay);
+
     boost::asio::io_context ioContext_;
     udp::socket socket_;
     udp::endpoint endpoint_;
+
+    PacingConfig pacing_;
+    bool kernelPacing_ = false;
+    std::uint64_t kernelRate_ = 0;    // Текущий SO_MAX_PACING_RATE, байт/с
+    std::unique_ptr<TokenBucketPacer> pacer_;
+    std::uint64_t frameBytes_ = 0;    // Отправлено в текущем кадре
+    std::uint32_t nextPacketId_ = 0;
+    std::vector<unsigned char> fragment_;
+
+    // В режиме кадра корзина вмещает несколько датаграмм, иначе кадр уходит одной пачкой
+    static constexpr size_t frameBurstDatagrams_ = 4;
+
+    // Статистика задержки, добавленной сглаживанием
+    std::chrono::nanoseconds totalDelay_{0};
+    std::chrono::nanoseconds maxDelay_{0};
+    size_t pacedFrames_ = 0;
+    static constexpr size_t reportInterval_ = 300;
 };
 
 #endif // UDP_SENDER_HPP
@@ -0,0 +1,84 @@
+#ifndef URING_CONTEXT_HPP
+#define URING_CONTEXT_HPP
+
+#include <liburing.h>
+#include <deque>
+#include <vector>
+
+// Обёртка над io_uring: кольцо SQ/CQ, зарегистрированные в ядре буферы отправки
+// и кольцо предоставленных ядру буферов (provided buffer ring) для multishot-приёма.
+class UringContext {
+public:
+    static constexpr unsigned kQueueDepth = 256;
+    static constexpr unsigned kBufferCount = 256;      // Степень двойки
+    static constexpr unsigned kBufferSize = 65536;
+    static constexpr unsigned short kBufferGroup = 0;
+
+    // Буферы отправки регистрируются в ядре один раз (io_uring_register_buffers)
+    // и принадлежат контексту, пока ядро не пришлёт уведомление SEND_ZC
+    static constexpr unsigned kSendBufferCount = 16;
+    static constexpr size_t kSendBufferSize = 512 * 1024;
+
+    // Проверка, что ядро поддерживает нужные операции (multishot recv, SEND_ZC)
+    static bool isSupported();
+
+    UringContext();
+    ~UringContext();
+    UringContext(const UringContext&) = delete;
+    UringContext& operator=(const UringContext&) = delete;
+
+    // Буфер под следующую отправку размером не меньше size. Если все буферы
+    // ещё у ядра, ждёт возврата хотя бы одного. Бросает std::system_error.
+    unsigned char* prepareSend(size_t size);
+
+    // Сразу отдаёт подготовленный буфер ядру, не дожидаясь результата. Буферы
+    // от zeroCopyThreshold байт и крупнее уходят через SEND_ZC.
+    // Бросает std::system_error, если предыдущая отправка завершилась ошибкой.
+    void queueSend(int fd, size_t size, size_t zeroCopyThreshold);
+
+    // Ждёт результатов всех отданных ядру отправок. Уведомления об освобождении
+    // буферов не ждёт — они собираются на следующих вызовах.
+    // Бросает std::system_error при ошибке сокета.
+    void waitSends();
+
+    // Принимает всё, что уже накоплено в CQ, одним пакетом; при необходимости
+    // перевзводит multishot recv. Блокируется, пока не придёт хотя бы одно сообщение.
+    // Возвращает false, если соединение закрыто.
+    bool receiveBatch(int fd, std::deque<std::vector<unsigned char>>& out);
+
+private:
+    // Буфер отправки и его состояние в ядре
+    struct SendBuffer {
+        unsigned char* data = nullptr;        // Участок зарегистрированной области
+        std::vector<unsigned char> overflow;  // Кадр крупнее kSendBufferSize, без регистрации
+        size_t size = 0;
+        bool busy = false;                    // Занят от prepareSend до возврата ядром
+        bool awaitingResult = false;
+        bool awaitingNotification = false;
+    };
+
+    void setupSendBuffers();
+    void setupBufferRing();
+    void armMultishotRecv(int fd);
+    void recycleBuffer(unsigned short bufferId);
+    io_uring_sqe* getSqe();
+
+    // Разбор готовых CQE отправки; wait — ждать хотя бы одного
+    void reapSendCompletions(bool wait);
+    void handleSendCompletion(const io_uring_cqe* cqe);
+    SendBuffer* findFreeSendBuffer();
+
+    io_uring ring_;
+    io_uring_buf_ring* bufferRing_;
+    std::vector<unsigned char> buffers_;
+    bool recvArmed_;
+
+    std::vector<unsigned char> sendArena_;
+    std::vector<SendBuffer> sendBuffers_;
+    bool sendBuffersRegistered_;
+    SendBuffer* preparedSend_;             // Выдан prepareSend, ещё не поставлен в очередь
+    unsigned pendingResults_;
+    int sendError_;                        // Первая ошибка отправки (errno) или 0
+};
+
+#endif // URING_CONTEXT_HPP
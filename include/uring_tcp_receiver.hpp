@@ -0,0 +1,32 @@
+#ifndef URING_TCP_RECEIVER_HPP
+#define URING_TCP_RECEIVER_HPP
+
+#include "receiver.hpp"
+#include "uring_context.hpp"
+#include <boost/asio.hpp>
+#include <atomic>
+#include <deque>
+
+class UringTCPReceiver : public Receiver {
+public:
+    explicit UringTCPReceiver(unsigned short port);
+    void start() override;
+    std::vector<unsigned char> receive() override;
+    void stop() override;
+
+private:
+    // Выделяет из накопленного потока очередной пакет с префиксом длины
+    bool nextPacket(std::vector<unsigned char>& packet);
+
+    boost::asio::io_context ioContext_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    boost::asio::ip::tcp::socket socket_;
+    UringContext uring_;
+    std::deque<std::vector<unsigned char>> pending_;
+    std::vector<unsigned char> stream_;   // Принятые байты, ещё не разобранные на пакеты
+    size_t streamOffset_ = 0;
+    bool isConnected_;
+    std::atomic<bool> stopping_{false};
+};
+
+#endif // URING_TCP_RECEIVER_HPP
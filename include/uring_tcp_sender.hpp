@@ -0,0 +1,35 @@
+#ifndef URING_TCP_SENDER_HPP
+#define URING_TCP_SENDER_HPP
+
+#include <boost/asio.hpp>
+#include <string>
+#include <vector>
+#include "sender.hpp"
+#include "uring_context.hpp"
+
+// TCP-отправитель на io_uring: соединение устанавливает Asio, данные идут через кольцо
+class UringTCPSender : public Sender {
+public:
+    UringTCPSender(const std::string& address, unsigned short port);
+    ~UringTCPSender();
+
+    void start() override;
+    void send(const std::vector<unsigned char>& data) override;
+    // Пакет собирается прямо в зарегистрированном буфере и сразу уходит ядру,
+    // чтобы полоса не ждала остальные полосы кадра
+    void sendFrame(const std::string& metadata, const std::vector<unsigned char>& payload) override;
+    // Только собирает результаты отправок кадра
+    void flush() override;
+
+private:
+    boost::asio::io_context ioContext_;
+    boost::asio::ip::tcp::socket socket_;
+    boost::asio::ip::tcp::endpoint endpoint_;
+    UringContext uring_;
+    bool isConnected_;
+
+    // Ниже порога копирование дешевле, чем закрепление страниц для SEND_ZC
+    static constexpr size_t zeroCopyThreshold_ = 16 * 1024;
+};
+
+#endif // URING_TCP_SENDER_HPP
@@ -0,0 +1,25 @@
+#ifndef URING_UDP_RECEIVER_HPP
+#define URING_UDP_RECEIVER_HPP
+
+#include "receiver.hpp"
+#include "datagram_fragment.hpp"
+#include "uring_context.hpp"
+#include <boost/asio.hpp>
+#include <deque>
+
+class UringUDPReceiver : public Receiver {
+public:
+    explicit UringUDPReceiver(unsigned short port);
+    void start() override;
+    std::vector<unsigned char> receive() override;
+    void stop() override;
+
+private:
+    boost::asio::io_context ioContext_;
+    boost::asio::ip::udp::socket socket_;
+    UringContext uring_;
+    std::deque<std::vector<unsigned char>> pending_;
+    FragmentAssembler assembler_;
+};
+
+#endif // URING_UDP_RECEIVER_HPP
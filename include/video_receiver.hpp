@@ -3,29 +3,95 @@
 
 #include "udp_receiver.hpp"
 #include "tcp_receiver.hpp"
+#include "io_backend.hpp"
+#include "protocol_type.hpp"
+#include "thread_config.hpp"
+#include "stage_pool.hpp"
+#ifdef VIDEOSTREAMER_HAS_IO_URING
+#include "uring_tcp_receiver.hpp"
+#include "uring_udp_receiver.hpp"
+#endif
+#ifdef VIDEOSTREAMER_HAS_SHM
+#include "shm_receiver.hpp"
+#endif
 #include <opencv2/opencv.hpp>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <thread>
 #include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <cstdint>
 #include <nlohmann/json.hpp>
 #include "logger.hpp"
-enum class ProtocolType { UDP, TCP };
 
 class VideoReceiver {
 public:
-    
+    // Сведения о кадре из метаданных
+    struct FrameInfo {
+        std::int64_t timestampUs = 0;    // Момент захвата на отправителе (system_clock)
+        size_t encodedBytes = 0;         // Размер сжатых данных
+    };
+
+    // Приёмник декодированных кадров; вызывается из потока приёма или из пула декодирования полос
+    using FrameSink = std::function<void(const cv::Mat&, const FrameInfo&)>;
 
     VideoReceiver(ProtocolType protocol, unsigned short port,
                   unsigned short targetFPS = 30,
                   unsigned short videoWidth = 1280,
-                  unsigned short videoHeight = 720);
+                  unsigned short videoHeight = 720,
+                  IOBackend backend = IOBackend::Asio);
 
     void start();
+    // Прерывает приём (в том числе ожидание подключения) из другого потока; start() затем возвращается
+    void stop();
+
+    // Отдавать кадры во внешний приёмник (например, Qt) вместо окна HighGUI (вызывать до start)
+    void setFrameSink(FrameSink sink);
+
+    // Размещение потоков приёма и отображения (вызывать до start)
+    void setThreadingConfig(const ThreadingConfig& config);
+
+    // Число потоков параллельного декодирования полос; 0 — по числу ядер (вызывать до start)
+    void setSliceThreads(unsigned threads);
 
 private:
+    // Сжатая полоса кадра, ожидающая декодирования
+    struct SliceJob {
+        std::uint64_t streamId;
+        std::uint64_t frameId;
+        int index;
+        int count;
+        int y;
+        int height;
+        int frameWidth;
+        int frameHeight;
+        std::int64_t timestampUs;
+        std::vector<unsigned char> data;
+    };
+
+    // Собираемый из полос кадр
+    struct SliceFrame {
+        std::uint64_t streamId;
+        std::uint64_t id;
+        cv::Mat image;
+        FrameInfo info;
+        std::vector<bool> filled;
+        int decoded = 0;
+        int inFlight = 0;
+        bool closed = false;      // Пришёл более новый кадр — недостающих полос уже не ждём
+    };
+
     void receiveFrames();
+    // Возвращает целый кадр либо заполняет slice для параллельного декодирования
+    cv::Mat decodePacket(const unsigned char* data, size_t size, std::shared_ptr<SliceJob>& slice, FrameInfo& info);
+    void dispatchSlice(const std::shared_ptr<SliceJob>& job);
+    void decodeSlice(const std::shared_ptr<SliceFrame>& frame, const std::shared_ptr<SliceJob>& job);
+    void emitSliceFrame(const std::shared_ptr<SliceFrame>& frame);
+    void deliverFrame(const cv::Mat& frame, const FrameInfo& info);
+    void enqueueFrame(const cv::Mat& frame);
     void displayFrames(int videoWidth, int videoHeight, int targetFPS);
 
     ProtocolType protocol_;
@@ -34,12 +100,30 @@ private:
     unsigned short videoHeight_;
 
     std::unique_ptr<Receiver> receiver_;
+    FrameSink frameSink_;
     std::queue<cv::Mat> frameQueue;
     std::mutex queueMutex;
     std::condition_variable frameCondVar;
-    std::atomic<bool> stopDisplay;
+    std::atomic<bool> stopDisplay{false};
+
+    ThreadingConfig threading_;
+    ThreadStats threadStats_;
+
+    // Сборка кадров из полос
+    std::mutex sliceMutex_;
+    std::map<std::uint64_t, std::shared_ptr<SliceFrame>> sliceFrames_;
+    std::uint64_t sliceStreamId_ = 0;     // stream_id отправителя; смена — перезапуск, номера кадров с нуля
+    std::uint64_t lastSliceFrameId_ = 0;
+    bool hasSliceFrame_ = false;
+    unsigned sliceThreads_ = 0;
 
     static constexpr size_t maxQueueSize = 100;
+    // Предел размеров кадра из метаданных: защита от испорченных и чужих пакетов
+    static constexpr int maxFrameDimension = 16384;
+
+    // Пул декодирования полос создаётся с первой полосой, чтобы потоки без полос
+    // не держали простаивающих потоков; объявлен последним, чтобы остановиться первым
+    std::unique_ptr<StagePool> decodePool_;
 };
 
 #endif // VIDEO_RECEIVER_HPP
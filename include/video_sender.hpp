@@ -11,19 +11,32 @@
 #include <queue>
 #include <condition_variable>
 #include <memory>
+#include <cstdint>
+#include <functional>
 #include <nlohmann/json.hpp>
 #include "logger.hpp"
 #include "udp_sender.hpp"
 #include "tcp_sender.hpp"
-
-// Перечисления для протоколов передачи
-enum class ProtocolType { TCP, UDP };
+#include "io_backend.hpp"
+#include "protocol_type.hpp"
+#include "thread_config.hpp"
+#include "stage_pool.hpp"
+#ifdef VIDEOSTREAMER_HAS_IO_URING
+#include "uring_tcp_sender.hpp"
+#endif
+#ifdef VIDEOSTREAMER_HAS_SHM
+#include "shm_sender.hpp"
+#endif
 
 class VideoSender {
 public:
+    // Внешний источник кадров вместо камеры; false — источник исчерпан
+    using FrameSource = std::function<bool(cv::Mat&)>;
+
     // Конструктор для работы с камерой
     VideoSender(const std::string& address, unsigned short port,
-                unsigned short cameraIndex, ProtocolType protocol);
+                unsigned short cameraIndex, ProtocolType protocol,
+                IOBackend backend = IOBackend::Asio);
 
     // Запуск видеопередачи
     void start();
@@ -31,13 +44,40 @@ public:
     // Завершение работы
     void stop();
 
+    // Размещение потоков захвата и отправки (вызывать до start)
+    void setThreadingConfig(const ThreadingConfig& config);
+
+    // Сглаживание отправки кадров (только для UDP)
+    void setPacing(const PacingConfig& config);
+
+    // Разбиение кадра на горизонтальные полосы, кодируемые параллельно (вызывать до start).
+    // slices <= 1 — кадр целиком; threads = 0 — по числу ядер
+    void setSlicing(unsigned slices, unsigned threads);
+
+    // Настройки конвейера (вызывать до start)
+    void setFrameSource(FrameSource source);
+    void setJpegQuality(int quality);
+    void setMaxQueueSize(size_t size);
+
 private:
+    // Кадр в очереди вместе с моментом захвата
+    struct CapturedFrame {
+        std::shared_ptr<cv::Mat> image;
+        std::int64_t timestampUs = 0;     // system_clock, микросекунды от эпохи
+    };
+
     // Поток захвата кадров
     void captureFrame();
 
     // Поток отправки кадров
     void sendFrame();
 
+    // Кодирование и отправка кадра или полосы; потокобезопасно
+    void encodeAndSend(const cv::Mat& image, const nlohmann::json& metadata);
+
+    // Параллельное кодирование полос кадра; возвращает управление, когда ушли все полосы
+    void sendSlices(const std::shared_ptr<cv::Mat>& frame, std::int64_t timestampUs);
+
     // Генерация метаданных для кадра
     nlohmann::json generateMetadata();
 
@@ -46,24 +86,37 @@ private:
     std::string address_;                 // IP-адрес получателя
     unsigned short port_;                 // Порт получателя
     unsigned short cameraIndex_;          // Индекс камеры
-    ProtocolType protocol_;               // Протокол передачи (TCP или UDP)
+    ProtocolType protocol_;               // Протокол передачи (TCP, UDP или SHM)
     std::atomic<bool> stopFlag{false};    // Флаг завершения потоков
 
-    std::unique_ptr<Sender> sender_;      // Указатель на объект передачи (TCP/UDP)
+    std::unique_ptr<Sender> sender_;      // Указатель на объект передачи (TCP/UDP/SHM)
+    FrameSource frameSource_;             // Источник кадров; пусто — камера cameraIndex_
 
     // Параметры компрессии
     std::vector<int> compression_params_ = {cv::IMWRITE_JPEG_QUALITY, 90};
 
     // Очередь для кадров
-    std::queue<std::shared_ptr<cv::Mat>> frameQueue_; // Очередь для хранения кадров
+    std::queue<CapturedFrame> frameQueue_; // Очередь для хранения кадров
     size_t maxQueueSize_ = 10;            // Максимальный размер очереди
 
     // Синхронизация потоков
     std::mutex frameQueueMutex_;          // Мьютекс для очереди
     std::condition_variable frameCondVar_; // Условная переменная для синхронизации
 
+    // Размещение потоков и учёт их CPU-времени
+    ThreadingConfig threading_;
+    ThreadStats threadStats_;
+
     // Вспомогательные данные
     std::vector<unsigned char> buffer_;  // Буфер для кодированного изображения
+
+    // Полосы кадра
+    unsigned sliceCount_ = 1;             // Число полос на кадр
+    unsigned sliceThreads_ = 0;           // Потоки кодирования полос, 0 — по числу ядер
+    std::uint64_t frameId_ = 0;           // Номер кадра для сборки полос на приёмнике
+    std::uint32_t streamId_;              // Случайный номер запуска: приёмник по нему замечает перезапуск
+    std::mutex sendMutex_;                // Отправка полос из нескольких потоков
+    std::unique_ptr<StagePool> encodePool_; // Пул кодирования полос, создаётся с первым кадром
 };
 
 #endif // VIDEO_SENDER_HPP
@@ -0,0 +1,113 @@
+#include "datagram_fragment.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr unsigned char kMagic[4] = {0xFF, 'V', 'S', 'F'};
+// Защита от заголовка с заведомо неверным размером
+constexpr size_t kMaxPacketSize = 64 * 1024 * 1024;
+
+void putU32(unsigned char* out, std::uint32_t value) {
+    out[0] = static_cast<unsigned char>(value >> 24);
+    out[1] = static_cast<unsigned char>(value >> 16);
+    out[2] = static_cast<unsigned char>(value >> 8);
+    out[3] = static_cast<unsigned char>(value);
+}
+
+void putU16(unsigned char* out, std::uint16_t value) {
+    out[0] = static_cast<unsigned char>(value >> 8);
+    out[1] = static_cast<unsigned char>(value);
+}
+
+std::uint32_t getU32(const unsigned char* in) {
+    return static_cast<std::uint32_t>(in[0]) << 24 | static_cast<std::uint32_t>(in[1]) << 16 |
+           static_cast<std::uint32_t>(in[2]) << 8 | static_cast<std::uint32_t>(in[3]);
+}
+
+std::uint16_t getU16(const unsigned char* in) {
+    return static_cast<std::uint16_t>(in[0] << 8 | in[1]);
+}
+
+} // namespace
+
+size_t fragmentCount(size_t packetSize, size_t datagramSize) {
+    size_t chunkSize = datagramSize - kFragmentHeaderSize;
+    return std::max<size_t>(1, (packetSize + chunkSize - 1) / chunkSize);
+}
+
+void writeFragment(std::vector<unsigned char>& datagram, const std::vector<unsigned char>& packet,
+                   size_t datagramSize, std::uint32_t packetId, size_t index) {
+    size_t chunkSize = datagramSize - kFragmentHeaderSize;
+    size_t offset = index * chunkSize;
+    size_t length = std::min(chunkSize, packet.size() - offset);
+
+    datagram.resize(kFragmentHeaderSize + length);
+    unsigned char* header = datagram.data();
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    putU32(header + 4, packetId);
+    putU32(header + 8, static_cast<std::uint32_t>(packet.size()));
+    putU32(header + 12, static_cast<std::uint32_t>(chunkSize));
+    putU16(header + 16, static_cast<std::uint16_t>(index));
+    putU16(header + 18, static_cast<std::uint16_t>(fragmentCount(packet.size(), datagramSize)));
+    std::memcpy(datagram.data() + kFragmentHeaderSize, packet.data() + offset, length);
+}
+
+void FragmentAssembler::reset(std::uint32_t packetId, size_t packetSize, size_t chunkSize, size_t count) {
+    active_ = true;
+    packetId_ = packetId;
+    chunkSize_ = chunkSize;
+    missing_ = count;
+    packet_.resize(packetSize);
+    received_.assign(count, false);
+}
+
+bool FragmentAssembler::add(std::vector<unsigned char>&& datagram, std::vector<unsigned char>& packet) {
+    if (datagram.size() < kFragmentHeaderSize || std::memcmp(datagram.data(), kMagic, sizeof(kMagic)) != 0) {
+        packet = std::move(datagram);
+        return true;
+    }
+
+    const unsigned char* header = datagram.data();
+    std::uint32_t packetId = getU32(header + 4);
+    size_t packetSize = getU32(header + 8);
+    size_t chunkSize = getU32(header + 12);
+    size_t index = getU16(header + 16);
+    size_t count = getU16(header + 18);
+    size_t length = datagram.size() - kFragmentHeaderSize;
+    if (packetSize == 0 || packetSize > kMaxPacketSize || chunkSize == 0 || index >= count ||
+        count != (packetSize + chunkSize - 1) / chunkSize ||
+        length != std::min(chunkSize, packetSize - index * chunkSize)) {
+        Logger::getInstance().log("Malformed datagram fragment dropped");
+        return false;
+    }
+
+    if (completed_ && packetId == completedId_) {
+        return false;
+    }
+    if (!active_ || packetId != packetId_ || packetSize != packet_.size() || chunkSize != chunkSize_) {
+        // Фрагменты одного отправителя идут пакет за пакетом: начало нового
+        // пакета означает, что недостающие части предыдущего потеряны
+        if (active_ && missing_ > 0) {
+            Logger::getInstance().log("Incomplete fragmented packet dropped: " + std::to_string(missing_) +
+                                      " of " + std::to_string(received_.size()) + " fragments lost");
+        }
+        reset(packetId, packetSize, chunkSize, count);
+    }
+    if (received_[index]) {
+        return false;
+    }
+    received_[index] = true;
+    std::memcpy(packet_.data() + index * chunkSize, header + kFragmentHeaderSize, length);
+    if (--missing_ > 0) {
+        return false;
+    }
+
+    active_ = false;
+    completed_ = true;
+    completedId_ = packetId;
+    packet = std::move(packet_);
+    packet_.clear();
+    return true;
+}
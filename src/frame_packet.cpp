@@ -0,0 +1,57 @@
+#include "frame_packet.hpp"
+#include <algorithm>
+#include <cstring>
+
+std::vector<unsigned char> buildFramePacket(const std::string& metadata, const std::vector<unsigned char>& payload) {
+    std::vector<unsigned char> packet;
+    packet.reserve(framePacketSize(metadata, payload));
+    packet.insert(packet.end(), metadata.begin(), metadata.end());
+    packet.push_back(0);
+    packet.insert(packet.end(), payload.begin(), payload.end());
+    return packet;
+}
+
+size_t framePacketSize(const std::string& metadata, const std::vector<unsigned char>& payload) {
+    return metadata.size() + 1 + payload.size();
+}
+
+void writeFramePacket(unsigned char* destination, const std::string& metadata, const std::vector<unsigned char>& payload) {
+    std::memcpy(destination, metadata.data(), metadata.size());
+    destination[metadata.size()] = 0;
+    if (!payload.empty()) {
+        std::memcpy(destination + metadata.size() + 1, payload.data(), payload.size());
+    }
+}
+
+bool parseFramePacket(const unsigned char* data, size_t size, MetaData& metaData,
+                      const unsigned char*& payload, size_t& payloadSize) {
+    const unsigned char* end = data + size;
+    const unsigned char* separatorPos = std::find(data, end, 0);
+    if (separatorPos == end) {
+        Logger::getInstance().log("Error: No metadata separator found!");
+        return false;
+    }
+
+    std::vector<unsigned char> metadataBytes(data, separatorPos);
+    metaData.parse(metadataBytes);
+    if (!metaData.isValid() || separatorPos + 1 == end) {
+        return false;
+    }
+
+    payload = separatorPos + 1;
+    payloadSize = static_cast<size_t>(end - payload);
+    return true;
+}
+
+void writeStreamLength(unsigned char* destination, size_t size) {
+    auto value = static_cast<std::uint32_t>(size);
+    destination[0] = static_cast<unsigned char>(value >> 24);
+    destination[1] = static_cast<unsigned char>(value >> 16);
+    destination[2] = static_cast<unsigned char>(value >> 8);
+    destination[3] = static_cast<unsigned char>(value);
+}
+
+size_t readStreamLength(const unsigned char* source) {
+    return static_cast<size_t>(source[0]) << 24 | static_cast<size_t>(source[1]) << 16 |
+           static_cast<size_t>(source[2]) << 8 | static_cast<size_t>(source[3]);
+}
@@ -0,0 +1,22 @@
+#include "io_backend.hpp"
+#include "logger.hpp"
+
+#ifdef VIDEOSTREAMER_HAS_IO_URING
+#include "uring_context.hpp"
+#endif
+
+IOBackend selectIOBackend(const std::string& requested) {
+    if (requested != "io_uring") {
+        return IOBackend::Asio;
+    }
+#ifdef VIDEOSTREAMER_HAS_IO_URING
+    if (UringContext::isSupported()) {
+        Logger::getInstance().log("Using io_uring network backend.");
+        return IOBackend::IoUring;
+    }
+    Logger::getInstance().log("io_uring is not supported by the kernel, falling back to Asio.");
+#else
+    Logger::getInstance().log("Built without io_uring support, falling back to Asio.");
+#endif
+    return IOBackend::Asio;
+}
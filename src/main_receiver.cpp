@@ -1,8 +1,58 @@
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 #include <yaml-cpp/yaml.h>
+#include <QApplication>
 #include "video_receiver.hpp"
+#include "qt_display.hpp"
 
-int main() {
+// Отображение через Qt: декодирование в потоках приёма, UI — в главном потоке.
+// Несколько портов из mosaicPorts выводятся мозаикой в одном окне.
+static int runQtDisplay(int argc, char* argv[], const YAML::Node& config, ProtocolType protocol,
+                        unsigned short port, unsigned short targetFPS,
+                        unsigned short videoWidth, unsigned short videoHeight, IOBackend backend,
+                        unsigned sliceThreads) {
+    std::vector<unsigned short> ports;
+    if (config["mosaicPorts"]) {
+        ports = config["mosaicPorts"].as<std::vector<unsigned short>>();
+    }
+    if (ports.empty()) {
+        ports.push_back(port);
+    }
+
+    QApplication app(argc, argv);
+    MosaicWindow window(ports.size(), videoWidth, videoHeight);
+
+    std::vector<std::unique_ptr<VideoReceiver>> receivers;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ports.size(); ++i) {
+        auto receiver = std::make_unique<VideoReceiver>(protocol, ports[i], targetFPS, videoWidth, videoHeight, backend);
+        receiver->setThreadingConfig(loadThreadingConfig(config["threading"]));
+        receiver->setSliceThreads(sliceThreads);
+        VideoTile* tile = window.tile(i);
+        receiver->setFrameSink([tile](const cv::Mat& frame, const VideoReceiver::FrameInfo&) {
+            tile->submitFrame(frame);
+        });
+        threads.emplace_back(&VideoReceiver::start, receiver.get());
+        receivers.push_back(std::move(receiver));
+    }
+
+    window.show();
+    int result = app.exec();
+
+    // stop() закрывает сокеты и кольца, поэтому потоки приёма выходят из
+    // блокирующего receive(); окно ещё живо, пока они отдают последние кадры
+    for (auto& receiver : receivers) {
+        receiver->stop();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
     std::string config_path = std::string(CONFIG_DIR) + "/videoConfigure.yaml";;
     YAML::Node config = YAML::LoadFile(config_path);
 
@@ -11,9 +61,25 @@ int main() {
     unsigned short videoWidth = config["videoWidth"].as<unsigned short>();
     unsigned short videoHeight = config["videoHeight"].as<unsigned short>();
     std::string protocolType = config["protocolType"].as<std::string>();
-    ProtocolType protocol = (protocolType == "udp") ? ProtocolType::UDP : ProtocolType::TCP;
+    ProtocolType protocol = ProtocolType::TCP;
+    if (protocolType == "udp") {
+        protocol = ProtocolType::UDP;
+    } else if (protocolType == "shm") {
+        protocol = ProtocolType::SHM;
+    }
+
+    IOBackend backend = selectIOBackend(config["ioBackend"] ? config["ioBackend"].as<std::string>() : "asio");
+    unsigned sliceThreads = config["sliceThreads"] ? config["sliceThreads"].as<unsigned>() : 0;
+
+    std::string display = config["display"] ? config["display"].as<std::string>() : "highgui";
+    if (display == "qt") {
+        return runQtDisplay(argc, argv, config, protocol, port, targetFPS, videoWidth, videoHeight, backend,
+                            sliceThreads);
+    }
 
-    VideoReceiver receiver(protocol, port, targetFPS, videoWidth, videoHeight);
+    VideoReceiver receiver(protocol, port, targetFPS, videoWidth, videoHeight, backend);
+    receiver.setThreadingConfig(loadThreadingConfig(config["threading"]));
+    receiver.setSliceThreads(sliceThreads);
     receiver.start();
 
     return 0;
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <yaml-cpp/yaml.h>
 #include "video_sender.hpp"
+#include "synthetic_source.hpp"
 
 int main() {
     try {
@@ -13,12 +14,33 @@ int main() {
         std::string ip_address = config["ip_address"].as<std::string>();
         std::string protocolType = config["protocolType"].as<std::string>();
         unsigned short cameraIndex = config["videoSource"].as<unsigned short>();
+        unsigned short targetFPS = config["targetFPS"].as<unsigned short>();
 
         // Определение протокола
-        ProtocolType protocol = (protocolType == "udp") ? ProtocolType::UDP : ProtocolType::TCP;
+        ProtocolType protocol = ProtocolType::TCP;
+        if (protocolType == "udp") {
+            protocol = ProtocolType::UDP;
+        } else if (protocolType == "shm") {
+            protocol = ProtocolType::SHM;
+        }
+
+        // Сетевой бэкенд выбирается один раз при старте
+        IOBackend backend = selectIOBackend(config["ioBackend"] ? config["ioBackend"].as<std::string>() : "asio");
 
         // Создание и запуск VideoSender
-        VideoSender sender(ip_address, port, cameraIndex, protocol);
+        VideoSender sender(ip_address, port, cameraIndex, protocol, backend);
+        sender.setThreadingConfig(loadThreadingConfig(config["threading"]));
+        sender.setPacing(loadPacingConfig(config["pacing"], targetFPS));
+        sender.setSlicing(config["slices"] ? config["slices"].as<unsigned>() : 1,
+                          config["sliceThreads"] ? config["sliceThreads"].as<unsigned>() : 0);
+
+        // Синтетический источник вместо камеры
+        if (config["sourceType"] && config["sourceType"].as<std::string>() == "synthetic") {
+            auto source = std::make_shared<SyntheticSource>(
+                config["videoWidth"].as<int>(), config["videoHeight"].as<int>(), targetFPS,
+                config["syntheticComplexity"] ? config["syntheticComplexity"].as<double>() : 0.5);
+            sender.setFrameSource([source](cv::Mat& frame) { return source->read(frame); });
+        }
         sender.start();
 
     } catch (const std::exception& e) {
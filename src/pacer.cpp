@@ -0,0 +1,84 @@
+#include "pacer.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+// Последний отрезок ожидания докручиваем активно: sleep_for слишком неточен
+constexpr auto kSpinThreshold = std::chrono::microseconds(100);
+
+void preciseSleepUntil(std::chrono::steady_clock::time_point deadline) {
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return;
+        }
+        auto remaining = deadline - now;
+        if (remaining > kSpinThreshold) {
+            std::this_thread::sleep_for(remaining - kSpinThreshold);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace
+
+PacingConfig loadPacingConfig(const YAML::Node& node, unsigned targetFPS) {
+    PacingConfig config;
+    config.targetFPS = targetFPS;
+    if (!node || !node.IsMap()) {
+        return config;
+    }
+    if (node["enabled"]) {
+        config.enabled = node["enabled"].as<bool>();
+    }
+    if (node["mode"]) {
+        config.frameMode = node["mode"].as<std::string>() != "bitrate";
+    }
+    if (node["rateBps"]) {
+        config.rateBps = node["rateBps"].as<std::uint64_t>();
+    }
+    if (node["burstBytes"]) {
+        config.burstBytes = node["burstBytes"].as<std::size_t>();
+    }
+    if (node["kernelPacing"]) {
+        config.kernelPacing = node["kernelPacing"].as<bool>();
+    }
+    return config;
+}
+
+TokenBucketPacer::TokenBucketPacer(double bytesPerSecond, std::size_t burstBytes)
+    : rate_(bytesPerSecond),
+      burst_(static_cast<double>(burstBytes)),
+      tokens_(static_cast<double>(burstBytes)),
+      last_(std::chrono::steady_clock::now()) {}
+
+void TokenBucketPacer::refill(std::chrono::steady_clock::time_point now) {
+    std::chrono::duration<double> elapsed = now - last_;
+    tokens_ = std::min(burst_, tokens_ + elapsed.count() * rate_);
+    last_ = now;
+}
+
+void TokenBucketPacer::setRate(double bytesPerSecond) {
+    refill(std::chrono::steady_clock::now());
+    rate_ = bytesPerSecond;
+}
+
+std::chrono::nanoseconds TokenBucketPacer::acquire(std::size_t bytes) {
+    auto start = std::chrono::steady_clock::now();
+    refill(start);
+
+    // Датаграмма больше корзины всё равно уходит целиком — корзина уходит в минус,
+    // и следующая отправка ждёт дольше
+    double needed = std::min(static_cast<double>(bytes), burst_);
+    if (tokens_ < needed && rate_ > 0.0) {
+        std::chrono::duration<double> wait((needed - tokens_) / rate_);
+        preciseSleepUntil(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(wait));
+        refill(std::chrono::steady_clock::now());
+    }
+    tokens_ -= static_cast<double>(bytes);
+
+    return std::chrono::steady_clock::now() - start;
+}
@@ -0,0 +1,97 @@
+#include "qt_display.hpp"
+
+#include <QGridLayout>
+#include <QKeyEvent>
+#include <QMetaObject>
+#include <QPainter>
+#include <QRegion>
+#include <algorithm>
+#include <cmath>
+
+VideoTile::VideoTile(QWidget* parent) : QWidget(parent) {
+    // Весь прямоугольник перерисовывается вручную — фон не стираем
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setMinimumSize(160, 90);
+}
+
+void VideoTile::submitFrame(const cv::Mat& frame) {
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        pending_ = frame;
+    }
+    // Не копим события: если перерисовка уже запрошена, она возьмёт самый свежий кадр
+    if (!updateQueued_.exchange(true)) {
+        QMetaObject::invokeMethod(this, [this]() {
+            updateQueued_ = false;
+            update();
+        }, Qt::QueuedConnection);
+    }
+}
+
+void VideoTile::paintEvent(QPaintEvent* /*event*/) {
+    {
+        std::lock_guard<std::mutex> lock(frameMutex_);
+        if (!pending_.empty()) {
+            current_ = pending_;
+            pending_.release();
+            // QImage поверх данных cv::Mat без копирования и без cvtColor
+            image_ = QImage(current_.data, current_.cols, current_.rows,
+                            static_cast<qsizetype>(current_.step), QImage::Format_BGR888);
+        }
+    }
+
+    QPainter painter(this);
+    if (image_.isNull()) {
+        painter.fillRect(rect(), Qt::black);
+        return;
+    }
+
+    // Масштабирование с сохранением пропорций; без сглаживания — быстрый blit растеризатора
+    QSize scaled = image_.size().scaled(size(), Qt::KeepAspectRatio);
+    QRect target(QPoint((width() - scaled.width()) / 2, (height() - scaled.height()) / 2), scaled);
+
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(target, image_);
+
+    QRegion bars = QRegion(rect()).subtracted(QRegion(target));
+    for (const QRect& bar : bars) {
+        painter.fillRect(bar, Qt::black);
+    }
+}
+
+MosaicWindow::MosaicWindow(size_t tileCount, int videoWidth, int videoHeight) {
+    auto columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(tileCount))));
+    columns = std::max(columns, 1);
+    int rows = (static_cast<int>(tileCount) + columns - 1) / columns;
+
+    auto* layout = new QGridLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(2);
+
+    for (size_t i = 0; i < tileCount; ++i) {
+        auto* videoTile = new VideoTile(this);
+        int index = static_cast<int>(i);
+        layout->addWidget(videoTile, index / columns, index % columns);
+        tiles_.push_back(videoTile);
+    }
+
+    setWindowTitle("VideoReceiver");
+    if (tileCount == 1) {
+        resize(videoWidth, videoHeight);
+    } else {
+        resize(videoWidth / 2 * columns, videoHeight / 2 * std::max(rows, 1));
+    }
+}
+
+VideoTile* MosaicWindow::tile(size_t index) const {
+    return tiles_.at(index);
+}
+
+void MosaicWindow::keyPressEvent(QKeyEvent* event) {
+    if (event->key() == Qt::Key_Escape) {
+        close();
+        return;
+    }
+    QWidget::keyPressEvent(event);
+}
@@ -0,0 +1,124 @@
+#include "shm_receiver.hpp"
+#include "logger.hpp"
+#include <chrono>
+#include <thread>
+
+SHMReceiver::SHMReceiver(unsigned short port)
+    : name_(ShmRing::nameForPort(port)),
+      cursor_(0),
+      acquiredSeq_(0),
+      overruns_(0),
+      idleWaits_(0) {
+    Logger::getInstance().log("SHMReceiver initialized for " + name_);
+}
+
+void SHMReceiver::start() {
+    Logger::getInstance().log("Waiting for shared memory segment " + name_ + "...");
+    while (!attach()) {
+        if (stopping_) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(waitTimeoutMs_));
+    }
+    Logger::getInstance().log("SHMReceiver started.");
+}
+
+void SHMReceiver::stop() {
+    stopping_ = true;
+}
+
+bool SHMReceiver::attach() {
+    if (!ring_.open(name_)) {
+        return false;
+    }
+    // Новый читатель начинает с текущего кадра, а не с истории кольца
+    cursor_ = ring_.header()->head.load(std::memory_order_acquire);
+    idleWaits_ = 0;
+    return true;
+}
+
+const unsigned char* SHMReceiver::acquire(size_t& size) {
+    if (!ring_.isMapped()) {
+        // Старый сегмент брошен, новый ещё не создан
+        if (!attach()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(waitTimeoutMs_));
+            return nullptr;
+        }
+        Logger::getInstance().log("SHMReceiver re-attached to " + name_);
+    }
+    ShmRingHeader* header = ring_.header();
+
+    while (true) {
+        std::uint64_t head = header->head.load(std::memory_order_acquire);
+        if (head == cursor_) {
+            std::uint32_t notify = header->notify.load(std::memory_order_acquire);
+            if (header->head.load(std::memory_order_acquire) != cursor_) {
+                continue;
+            }
+            if (!ring_.wait(notify, waitTimeoutMs_)) {
+                // Перезапущенный писатель создаёт новый сегмент под тем же именем,
+                // а в старом кадры больше не появятся
+                if (++idleWaits_ >= staleCheckWaits_) {
+                    idleWaits_ = 0;
+                    if (!ring_.isCurrent()) {
+                        Logger::getInstance().log("SHMReceiver: segment " + name_ + " was recreated, re-attaching.");
+                        if (attach()) {
+                            header = ring_.header();
+                            continue;
+                        }
+                    }
+                }
+                return nullptr;
+            }
+            continue;
+        }
+        idleWaits_ = 0;
+
+        // Писатель обогнал читателя больше чем на кольцо — старые кадры потеряны
+        if (head - cursor_ > header->slotCount) {
+            std::uint64_t lost = head - header->slotCount - cursor_;
+            overruns_ += lost;
+            Logger::getInstance().log("SHMReceiver overrun: skipped " + std::to_string(lost) +
+                                      " frames (total " + std::to_string(overruns_) + ")");
+            cursor_ = head - header->slotCount;
+        }
+
+        ShmSlotHeader* slot = ring_.slot(cursor_);
+        std::uint64_t expected = 2 * cursor_ + 2;
+        std::uint64_t seq = slot->seq.load(std::memory_order_acquire);
+        if (seq != expected) {
+            // Слот уже занят более новым кадром
+            ++overruns_;
+            ++cursor_;
+            continue;
+        }
+
+        acquiredSeq_ = seq;
+        size = static_cast<size_t>(slot->size);
+        return ring_.slotData(cursor_);
+    }
+}
+
+bool SHMReceiver::release() {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    bool intact = ring_.slot(cursor_)->seq.load(std::memory_order_relaxed) == acquiredSeq_;
+    if (!intact) {
+        ++overruns_;
+        Logger::getInstance().log("SHMReceiver overrun: frame overwritten while reading.");
+    }
+    ++cursor_;
+    return intact;
+}
+
+std::vector<unsigned char> SHMReceiver::receive() {
+    size_t size = 0;
+    const unsigned char* data = acquire(size);
+    if (!data) {
+        return {};
+    }
+    std::vector<unsigned char> buffer(data, data + size);
+    if (!release()) {
+        return {};
+    }
+    return buffer;
+}
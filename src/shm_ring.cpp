@@ -0,0 +1,195 @@
+#include "shm_ring.hpp"
+#include "logger.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t kAlign = 64;
+
+constexpr std::size_t alignUp(std::size_t value) {
+    return (value + kAlign - 1) / kAlign * kAlign;
+}
+
+constexpr std::size_t kHeaderSize = alignUp(sizeof(ShmRingHeader));
+constexpr std::size_t kSlotHeaderSize = alignUp(sizeof(ShmSlotHeader));
+
+std::size_t slotStride(std::uint64_t slotSize) {
+    return kSlotHeaderSize + alignUp(static_cast<std::size_t>(slotSize));
+}
+
+std::size_t totalSize(std::uint32_t slotCount, std::uint64_t slotSize) {
+    return kHeaderSize + slotCount * slotStride(slotSize);
+}
+
+long futex(std::atomic<std::uint32_t>* addr, int op, std::uint32_t value, const timespec* timeout) {
+    // Без FUTEX_PRIVATE_FLAG: слово разделяется между процессами
+    return syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(addr), op, value, timeout, nullptr, 0);
+}
+
+} // namespace
+
+std::string ShmRing::nameForPort(unsigned short port) {
+    return "/videostreamer_" + std::to_string(port);
+}
+
+ShmRing::ShmRing() : owner_(false), base_(nullptr), mappedSize_(0), device_(0), inode_(0) {}
+
+ShmRing::~ShmRing() {
+    unmap();
+    if (owner_) {
+        shm_unlink(name_.c_str());
+    }
+}
+
+void ShmRing::create(const std::string& name, std::uint32_t slotCount, std::uint64_t slotSize) {
+    unmap();
+    name_ = name;
+
+    // Остатки предыдущего запуска удаляем, чтобы не унаследовать чужую геометрию
+    shm_unlink(name_.c_str());
+    int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("shm_open failed for " + name_ + ": " + std::strerror(errno));
+    }
+    owner_ = true;
+
+    std::size_t size = totalSize(slotCount, slotSize);
+    struct stat st {};
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0 || fstat(fd, &st) != 0) {
+        int err = errno;
+        close(fd);
+        throw std::runtime_error("ftruncate failed for " + name_ + ": " + std::strerror(err));
+    }
+    device_ = st.st_dev;
+    inode_ = st.st_ino;
+
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("mmap failed for " + name_ + ": " + std::strerror(errno));
+    }
+    base_ = base;
+    mappedSize_ = size;
+
+    // magic пишется последним, чтобы читатель не увидел наполовину инициализированный заголовок
+    auto* hdr = new (base_) ShmRingHeader{};
+    hdr->slotCount = slotCount;
+    hdr->slotSize = slotSize;
+    for (std::uint64_t i = 0; i < slotCount; ++i) {
+        new (static_cast<unsigned char*>(base_) + kHeaderSize + i * slotStride(slotSize)) ShmSlotHeader{};
+    }
+    hdr->magic.store(kMagic, std::memory_order_release);
+
+    Logger::getInstance().log("Shared memory ring " + name_ + " created: " + std::to_string(slotCount) +
+                              " slots x " + std::to_string(slotSize) + " bytes");
+}
+
+bool ShmRing::open(const std::string& name) {
+    unmap();
+    name_ = name;
+    owner_ = false;
+
+    int fd = shm_open(name_.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < kHeaderSize) {
+        close(fd);
+        return false;
+    }
+
+    void* base = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    base_ = base;
+    mappedSize_ = static_cast<std::size_t>(st.st_size);
+    device_ = st.st_dev;
+    inode_ = st.st_ino;
+
+    // Геометрию проверяем до totalSize: slotCount == 0 дал бы деление на ноль в slot(),
+    // а огромный slotSize — переполнение при подсчёте размера
+    auto* hdr = header();
+    if (hdr->magic.load(std::memory_order_acquire) != kMagic ||
+        hdr->slotCount == 0 || hdr->slotCount > mappedSize_ / kSlotHeaderSize ||
+        hdr->slotSize == 0 || hdr->slotSize > mappedSize_ ||
+        totalSize(hdr->slotCount, hdr->slotSize) > mappedSize_) {
+        unmap();
+        return false;
+    }
+    return true;
+}
+
+bool ShmRing::isMapped() const {
+    return base_ != nullptr;
+}
+
+ShmRingHeader* ShmRing::header() const {
+    return static_cast<ShmRingHeader*>(base_);
+}
+
+ShmSlotHeader* ShmRing::slot(std::uint64_t index) const {
+    auto* hdr = header();
+    std::size_t offset = kHeaderSize + (index % hdr->slotCount) * slotStride(hdr->slotSize);
+    return reinterpret_cast<ShmSlotHeader*>(static_cast<unsigned char*>(base_) + offset);
+}
+
+unsigned char* ShmRing::slotData(std::uint64_t index) const {
+    return reinterpret_cast<unsigned char*>(slot(index)) + kSlotHeaderSize;
+}
+
+bool ShmRing::wait(std::uint32_t expected, int timeoutMs) const {
+    timespec timeout{};
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+
+    auto* hdr = header();
+    hdr->waiters.fetch_add(1, std::memory_order_seq_cst);
+    long rc = futex(&hdr->notify, FUTEX_WAIT, expected, &timeout);
+    int err = errno;
+    hdr->waiters.fetch_sub(1, std::memory_order_relaxed);
+    return rc == 0 || err != ETIMEDOUT;
+}
+
+void ShmRing::wakeAll() const {
+    auto* hdr = header();
+    hdr->notify.fetch_add(1, std::memory_order_seq_cst);
+    // Системный вызов нужен, только если кто-то спит
+    if (hdr->waiters.load(std::memory_order_seq_cst) != 0) {
+        futex(&hdr->notify, FUTEX_WAKE, INT_MAX, nullptr);
+    }
+}
+
+bool ShmRing::isCurrent() const {
+    int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    bool same = fstat(fd, &st) == 0 && st.st_dev == device_ && st.st_ino == inode_;
+    close(fd);
+    return same;
+}
+
+void ShmRing::unmap() {
+    if (base_) {
+        munmap(base_, mappedSize_);
+        base_ = nullptr;
+        mappedSize_ = 0;
+    }
+}
@@ -0,0 +1,59 @@
+#include "shm_sender.hpp"
+#include "logger.hpp"
+#include <cstring>
+
+SHMSender::SHMSender(unsigned short port, std::uint32_t slotCount, std::uint64_t slotSize)
+    : name_(ShmRing::nameForPort(port)),
+      slotCount_(slotCount),
+      slotSize_(slotSize) {
+    Logger::getInstance().log("SHMSender initialized for " + name_);
+}
+
+void SHMSender::start() {
+    try {
+        ring_.create(name_, slotCount_, slotSize_);
+        Logger::getInstance().log("SHMSender started.");
+    } catch (const std::exception& e) {
+        Logger::getInstance().log("SHMSender start error: " + std::string(e.what()));
+        throw;
+    }
+}
+
+void SHMSender::send(const std::vector<unsigned char>& data) {
+    publish(data.size(), [&data](unsigned char* slotData) {
+        std::memcpy(slotData, data.data(), data.size());
+    });
+}
+
+void SHMSender::sendFrame(const std::string& metadata, const std::vector<unsigned char>& payload) {
+    publish(framePacketSize(metadata, payload), [&](unsigned char* slotData) {
+        writeFramePacket(slotData, metadata, payload);
+    });
+}
+
+template <typename Fill>
+void SHMSender::publish(size_t size, Fill&& fill) {
+    if (!ring_.isMapped()) {
+        return;
+    }
+    if (size > slotSize_) {
+        Logger::getInstance().log("SHMSender: frame of " + std::to_string(size) +
+                                  " bytes exceeds slot size, dropping.");
+        return;
+    }
+
+    ShmRingHeader* header = ring_.header();
+    std::uint64_t index = header->head.load(std::memory_order_relaxed);
+    ShmSlotHeader* slot = ring_.slot(index);
+
+    // Нечётный seq — слот в процессе записи
+    slot->seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    fill(ring_.slotData(index));
+    slot->size = size;
+
+    slot->seq.store(2 * index + 2, std::memory_order_release);
+    header->head.store(index + 1, std::memory_order_release);
+    ring_.wakeAll();
+}
@@ -0,0 +1,29 @@
+#include "stage_pool.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+
+StagePool::StagePool(ThreadStats& stats, const std::string& stage, const ThreadSettings& settings, unsigned threads) {
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    threads_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        threads_.emplace_back([this, &stats, stage, settings, i]() {
+            ThreadScope threadScope(stats, stage + "-" + std::to_string(i), settings);
+            pool_.attach();
+        });
+    }
+    Logger::getInstance().log("Thread pool " + stage + ": " + std::to_string(threads) + " threads");
+}
+
+StagePool::~StagePool() {
+    pool_.stop();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+unsigned StagePool::size() const {
+    return static_cast<unsigned>(threads_.size());
+}
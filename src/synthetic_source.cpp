@@ -0,0 +1,67 @@
+#include "synthetic_source.hpp"
+
+#include <algorithm>
+#include <thread>
+
+SyntheticSource::SyntheticSource(int width, int height, double fps, double complexity, size_t frameLimit)
+    : width_(width),
+      height_(height),
+      frameLimit_(frameLimit),
+      period_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / std::max(fps, 1.0)))) {
+    gradient_.create(height_, 2 * width_, CV_8UC3);
+    for (int y = 0; y < height_; ++y) {
+        auto* row = gradient_.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < 2 * width_; ++x) {
+            // Период градиента равен ширине кадра, поэтому сдвиг окна бесшовный
+            int phase = (x % width_) * 255 / std::max(width_ - 1, 1);
+            row[x] = cv::Vec3b(static_cast<uchar>(phase),
+                               static_cast<uchar>(y * 255 / std::max(height_ - 1, 1)),
+                               static_cast<uchar>(255 - phase));
+        }
+    }
+
+    complexity = std::clamp(complexity, 0.0, 1.0);
+    if (complexity > 0.0) {
+        noise_.create(height_, 2 * width_, CV_8UC3);
+        cv::randu(noise_, cv::Scalar::all(0), cv::Scalar::all(255.0 * complexity));
+    }
+}
+
+bool SyntheticSource::read(cv::Mat& frame) {
+    if (frameLimit_ > 0 && frameIndex_ >= frameLimit_) {
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (!started_) {
+        next_ = now;
+        started_ = true;
+    }
+    if (next_ > now) {
+        std::this_thread::sleep_until(next_);
+    }
+    next_ += period_;
+
+    int shift = static_cast<int>(frameIndex_ * 4 % static_cast<size_t>(width_));
+    cv::Mat background = gradient_(cv::Rect(shift, 0, width_, height_));
+    if (noise_.empty()) {
+        background.copyTo(frame);
+    } else {
+        int noiseShift = static_cast<int>(frameIndex_ * 7 % static_cast<size_t>(width_));
+        cv::add(background, noise_(cv::Rect(noiseShift, 0, width_, height_)), frame);
+    }
+
+    // Движущийся блок даёт локальное движение, как у реальной сцены
+    int blockSize = std::max(std::min(width_, height_) / 6, 1);
+    int blockX = static_cast<int>(frameIndex_ * 8 % static_cast<size_t>(std::max(width_ - blockSize, 1)));
+    int blockY = (height_ - blockSize) / 2;
+    frame(cv::Rect(blockX, blockY, blockSize, blockSize)).setTo(cv::Scalar(255, 255, 255));
+
+    ++frameIndex_;
+    return true;
+}
+
+size_t SyntheticSource::framesProduced() const {
+    return frameIndex_;
+}
@@ -1,4 +1,5 @@
 #include "tcp_receiver.hpp"
+#include "frame_packet.hpp"
 #include "logger.hpp"
 
 TCPReceiver::TCPReceiver(unsigned short port)
@@ -18,20 +19,36 @@ void TCPReceiver::start() {
         isConnected_ = true;
         Logger::getInstance().log("TCP connection accepted.");
     } catch (const std::exception& e) {
+        if (stopping_) {
+            return;
+        }
         Logger::getInstance().log(std::string("TCPReceiver start error: ") + e.what());
     }
 }
 
 std::vector<unsigned char> TCPReceiver::receive() {
+    if (stopping_) {
+        return {};
+    }
     if (!isConnected_) {
         Logger::getInstance().log("TCPReceiver is not connected. Cannot receive data.");
         return {};
     }
 
-    std::vector<unsigned char> buffer(65536);
+    // Пакет целиком: сначала длина, затем ровно столько байт
+    std::vector<unsigned char> buffer;
     try {
-        size_t length = socket_.read_some(boost::asio::buffer(buffer));
+        unsigned char header[kStreamLengthSize];
+        boost::asio::read(socket_, boost::asio::buffer(header));
+        size_t length = readStreamLength(header);
+        if (length > kMaxStreamPacketSize) {
+            // Поток рассинхронизирован, следующие байты уже не разобрать
+            Logger::getInstance().log("TCP packet length " + std::to_string(length) + " is out of range, closing connection.");
+            isConnected_ = false;
+            return {};
+        }
         buffer.resize(length);
+        boost::asio::read(socket_, boost::asio::buffer(buffer));
 
         auto remoteEndpoint = socket_.remote_endpoint();
         Logger::getInstance().logDetailed(
@@ -40,8 +57,29 @@ std::vector<unsigned char> TCPReceiver::receive() {
             remoteEndpoint.port(),
             length
         );
-    } catch (const std::exception& e) {
-        Logger::getInstance().log("TCP receive error: " + std::string(e.what()));
+    } catch (const boost::system::system_error& e) {
+        if (stopping_) {
+            return {};
+        }
+        if (e.code() == boost::asio::error::eof) {
+            Logger::getInstance().log("TCP connection closed by peer.");
+        } else {
+            Logger::getInstance().log("TCP receive error: " + std::string(e.what()));
+        }
+        isConnected_ = false;
+        return {};
     }
     return buffer;
-}
\ No newline at end of file
+}
+
+void TCPReceiver::stop() {
+    stopping_ = true;
+    // Блокирующие accept и read прерывает только shutdown на уровне сокета
+    boost::system::error_code ec;
+    socket_.shutdown(tcp::socket::shutdown_both, ec);
+#ifdef _WIN32
+    acceptor_.close(ec);
+#else
+    ::shutdown(acceptor_.native_handle(), SHUT_RDWR);
+#endif
+}
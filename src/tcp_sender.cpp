@@ -1,5 +1,7 @@
 #include "tcp_sender.hpp"
+#include "frame_packet.hpp"
 #include "logger.hpp"
+#include <array>
 
 TCPSender::TCPSender(const std::string& address, unsigned short port)
     : socket_(ioContext_),
@@ -36,7 +38,12 @@ void TCPSender::start() {
 void TCPSender::send(const std::vector<unsigned char>& data) {
     try {
         if (isConnected_ && socket_.is_open()) {
-            boost::asio::write(socket_, boost::asio::buffer(data));
+            // Длина и пакет уходят одним вызовом writev
+            unsigned char length[kStreamLengthSize];
+            writeStreamLength(length, data.size());
+            std::array<boost::asio::const_buffer, 2> buffers{
+                boost::asio::buffer(length), boost::asio::buffer(data)};
+            boost::asio::write(socket_, buffers);
         }
     } catch (const boost::system::system_error& e) {
         Logger::getInstance().log("Error in TCPSender::send: " + std::string(e.what()));
@@ -0,0 +1,223 @@
+#include "thread_config.hpp"
+#include "logger.hpp"
+
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+bool readCpuTime(clockid_t clock, std::chrono::nanoseconds& out) {
+    timespec ts{};
+    if (clock_gettime(clock, &ts) != 0) {
+        return false;
+    }
+    out = std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+    return true;
+}
+
+// NUMA-узел процессора по ссылке nodeN в sysfs; -1, если не определён
+int cpuNode(int cpu) {
+    std::error_code ec;
+    std::filesystem::directory_iterator it("/sys/devices/system/cpu/cpu" + std::to_string(cpu), ec);
+    for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+        std::string entry = it->path().filename().string();
+        if (entry.size() > 4 && entry.compare(0, 4, "node") == 0 &&
+            entry.find_first_not_of("0123456789", 4) == std::string::npos) {
+            return std::stoi(entry.substr(4));
+        }
+    }
+    return -1;
+}
+
+// Привязка памяти потока к узлам его процессоров. MPOL_LOCAL здесь бесполезен:
+// это политика ядра по умолчанию, а привязка нужна и для страниц, которые
+// первым коснётся этот поток (кадры OpenCV выделяются при захвате и декодировании).
+void bindMemoryToCpus(const std::string& name, const std::vector<int>& cpus) {
+    std::set<int> nodes;
+    for (int cpu : cpus) {
+        int node = cpuNode(cpu);
+        if (node >= 0) {
+            nodes.insert(node);
+        }
+    }
+    if (nodes.empty()) {
+        Logger::getInstance().log("NUMA node of CPUs for " + name + " is unknown, memory binding skipped");
+        return;
+    }
+
+    constexpr size_t bitsPerWord = sizeof(unsigned long) * CHAR_BIT;
+    std::vector<unsigned long> mask(static_cast<size_t>(*nodes.rbegin()) / bitsPerWord + 1, 0);
+    std::string nodeList;
+    for (int node : nodes) {
+        mask[static_cast<size_t>(node) / bitsPerWord] |= 1UL << (static_cast<size_t>(node) % bitsPerWord);
+        nodeList += (nodeList.empty() ? "" : ",") + std::to_string(node);
+    }
+    // Ядро читает maxnode - 1 бит
+    if (syscall(SYS_set_mempolicy, MPOL_BIND, mask.data(), mask.size() * bitsPerWord + 1) != 0) {
+        Logger::getInstance().log("Failed to bind memory of " + name + " to NUMA node(s) " + nodeList + ": " +
+                                  std::strerror(errno));
+        return;
+    }
+    Logger::getInstance().log("Memory of " + name + " bound to NUMA node(s) " + nodeList);
+}
+#endif
+
+void applySettings(const std::string& name, const ThreadSettings& settings) {
+#ifdef __linux__
+    // Имя потока в ядре ограничено 15 символами
+    std::string threadName = ("vs-" + name).substr(0, 15);
+    pthread_setname_np(pthread_self(), threadName.c_str());
+
+    if (!settings.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : settings.cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                CPU_SET(static_cast<size_t>(cpu), &set);
+            }
+        }
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (rc != 0) {
+            Logger::getInstance().log("Failed to set CPU affinity for " + name + ": " + std::strerror(rc));
+        }
+    }
+
+    if (settings.priority > 0) {
+        sched_param param{};
+        param.sched_priority = settings.priority;
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc != 0) {
+            Logger::getInstance().log("Failed to set SCHED_FIFO priority for " + name + ": " + std::strerror(rc));
+        }
+    }
+
+    if (settings.numaLocal) {
+        if (settings.cpus.empty()) {
+            Logger::getInstance().log("numaLocal for " + name + " requires cpus, ignoring");
+        } else {
+            bindMemoryToCpus(name, settings.cpus);
+        }
+    }
+#else
+    if (!settings.cpus.empty() || settings.priority > 0 || settings.numaLocal) {
+        Logger::getInstance().log("Thread placement is not supported on this platform, ignoring settings for " + name);
+    }
+#endif
+}
+
+} // namespace
+
+const ThreadSettings& ThreadingConfig::get(const std::string& stage) const {
+    static const ThreadSettings defaults;
+    auto it = stages.find(stage);
+    return it != stages.end() ? it->second : defaults;
+}
+
+ThreadingConfig loadThreadingConfig(const YAML::Node& node) {
+    ThreadingConfig config;
+    if (!node || !node.IsMap()) {
+        return config;
+    }
+
+    for (const auto& item : node) {
+        std::string key = item.first.as<std::string>();
+        const YAML::Node& value = item.second;
+
+        if (key == "statsInterval") {
+            config.statsIntervalSec = value.as<unsigned>();
+            continue;
+        }
+        if (!value.IsMap()) {
+            continue;
+        }
+
+        ThreadSettings settings;
+        if (value["cpus"]) {
+            settings.cpus = value["cpus"].as<std::vector<int>>();
+        }
+        if (value["priority"]) {
+            settings.priority = value["priority"].as<int>();
+        }
+        if (value["numaLocal"]) {
+            settings.numaLocal = value["numaLocal"].as<bool>();
+        }
+        config.stages[key] = settings;
+    }
+    return config;
+}
+
+size_t ThreadStats::add(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry entry;
+    entry.name = name;
+#ifdef __linux__
+    pthread_getcpuclockid(pthread_self(), &entry.clock);
+#endif
+    entries_.push_back(entry);
+    return entries_.size() - 1;
+}
+
+void ThreadStats::finish(size_t index) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = entries_[index];
+#ifdef __linux__
+    readCpuTime(entry.clock, entry.cpuTime);
+#endif
+    entry.alive = false;
+}
+
+void ThreadStats::report() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::stringstream ss;
+    ss << "Thread CPU time:";
+    for (Entry& entry : entries_) {
+#ifdef __linux__
+        if (entry.alive) {
+            readCpuTime(entry.clock, entry.cpuTime);
+        }
+        ss << " " << entry.name << "=" << std::chrono::duration_cast<std::chrono::milliseconds>(entry.cpuTime).count()
+           << "ms";
+#else
+        ss << " " << entry.name << "=n/a";
+#endif
+        if (!entry.alive) {
+            ss << "(exited)";
+        }
+    }
+    Logger::getInstance().log(ss.str());
+}
+
+void ThreadStats::runReporter(const std::atomic<bool>& stop, std::chrono::seconds interval) {
+    const auto step = std::chrono::milliseconds(100);
+    auto next = std::chrono::steady_clock::now() + interval;
+    while (!stop) {
+        std::this_thread::sleep_for(step);
+        if (std::chrono::steady_clock::now() >= next) {
+            report();
+            next += interval;
+        }
+    }
+}
+
+ThreadScope::ThreadScope(ThreadStats& stats, const std::string& name, const ThreadSettings& settings)
+    : stats_(stats) {
+    applySettings(name, settings);
+    index_ = stats_.add(name);
+}
+
+ThreadScope::~ThreadScope() {
+    stats_.finish(index_);
+}
@@ -22,6 +22,18 @@ std::vector<unsigned char> UDPReceiver::receive() {
         buffer.resize(length);
     } catch (const std::exception& e) {
         Logger::getInstance().log("Error receiving UDP data: " + std::string(e.what()));
+        return {};
     }
-    return buffer;
+    // Пока пакет собирается из фрагментов, возвращается пустой результат
+    std::vector<unsigned char> packet;
+    if (!assembler_.add(std::move(buffer), packet)) {
+        return {};
+    }
+    return packet;
+}
+
+void UDPReceiver::stop() {
+    // shutdown будит поток, ждущий датаграмму, даже на неподключённом UDP-сокете
+    boost::system::error_code ec;
+    socket_.shutdown(udp::socket::shutdown_both, ec);
 }
@@ -1,5 +1,151 @@
 #include "udp_sender.hpp"
 #include "logger.hpp"
+#include <algorithm>
+#include <limits>
+
+#ifdef __linux__
+#include <ifaddrs.h>
+#include <linux/netlink.h>
+#include <linux/pkt_sched.h>
+#include <linux/rtnetlink.h>
+#include <linux/sockios.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <map>
+#endif
+
+namespace {
+
+#ifdef __linux__
+// Интерфейс, через который уходят пакеты на адрес получателя; 0, если не найден
+unsigned egressInterface(const udp::endpoint& endpoint) {
+    int fd = socket(endpoint.protocol().family(), SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    // connect для UDP ничего не отправляет, только выбирает маршрут и адрес источника
+    sockaddr_storage local{};
+    socklen_t localSize = sizeof(local);
+    bool routed = connect(fd, endpoint.data(), static_cast<socklen_t>(endpoint.size())) == 0 &&
+                  getsockname(fd, reinterpret_cast<sockaddr*>(&local), &localSize) == 0;
+    close(fd);
+    if (!routed) {
+        return 0;
+    }
+
+    ifaddrs* addresses = nullptr;
+    if (getifaddrs(&addresses) != 0) {
+        return 0;
+    }
+    unsigned index = 0;
+    for (ifaddrs* it = addresses; it && index == 0; it = it->ifa_next) {
+        if (!it->ifa_addr || it->ifa_addr->sa_family != local.ss_family) {
+            continue;
+        }
+        bool same = false;
+        if (local.ss_family == AF_INET) {
+            same = reinterpret_cast<const sockaddr_in*>(it->ifa_addr)->sin_addr.s_addr ==
+                   reinterpret_cast<const sockaddr_in*>(&local)->sin_addr.s_addr;
+        } else if (local.ss_family == AF_INET6) {
+            same = std::memcmp(&reinterpret_cast<const sockaddr_in6*>(it->ifa_addr)->sin6_addr,
+                               &reinterpret_cast<const sockaddr_in6*>(&local)->sin6_addr, sizeof(in6_addr)) == 0;
+        }
+        if (same) {
+            index = if_nametoindex(it->ifa_name);
+        }
+    }
+    freeifaddrs(addresses);
+    return index;
+}
+
+// SO_MAX_PACING_RATE принимается любым сокетом, но соблюдает его для UDP только
+// qdisc fq: корневой fq или mq, у которого все дочерние очереди — fq
+bool interfaceUsesFq(unsigned ifindex) {
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct {
+        nlmsghdr header;
+        tcmsg message;
+    } request{};
+    request.header.nlmsg_len = sizeof(request);
+    request.header.nlmsg_type = RTM_GETQDISC;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.message.tcm_family = AF_UNSPEC;
+    request.message.tcm_ifindex = static_cast<int>(ifindex);
+    if (::send(fd, &request, sizeof(request), 0) < 0) {
+        close(fd);
+        return false;
+    }
+
+    std::string rootKind;
+    size_t children = 0;
+    size_t fqChildren = 0;
+    std::vector<char> buffer(32768);
+    bool done = false;
+    while (!done) {
+        ssize_t received = recv(fd, buffer.data(), buffer.size(), 0);
+        if (received <= 0) {
+            break;
+        }
+        // Разбор без макросов NLMSG_*/RTA_*: они не проходят -Wold-style-cast и -Wsign-conversion
+        const size_t total = static_cast<size_t>(received);
+        size_t offset = 0;
+        while (!done && offset + sizeof(nlmsghdr) <= total) {
+            const auto* header = reinterpret_cast<const nlmsghdr*>(buffer.data() + offset);
+            if (header->nlmsg_len < sizeof(nlmsghdr) || offset + header->nlmsg_len > total) {
+                break;
+            }
+            offset += NLMSG_ALIGN(header->nlmsg_len);
+            if (header->nlmsg_type == NLMSG_DONE || header->nlmsg_type == NLMSG_ERROR) {
+                done = true;
+                break;
+            }
+            const size_t messageOffset = NLMSG_ALIGN(sizeof(nlmsghdr));
+            if (header->nlmsg_type != RTM_NEWQDISC || header->nlmsg_len < messageOffset + sizeof(tcmsg)) {
+                continue;
+            }
+            const auto* message = reinterpret_cast<const tcmsg*>(reinterpret_cast<const char*>(header) + messageOffset);
+            if (message->tcm_ifindex != static_cast<int>(ifindex)) {
+                continue;
+            }
+
+            std::string kind;
+            size_t attributeOffset = messageOffset + NLMSG_ALIGN(sizeof(tcmsg));
+            while (attributeOffset + sizeof(rtattr) <= header->nlmsg_len) {
+                const auto* attribute = reinterpret_cast<const rtattr*>(reinterpret_cast<const char*>(header) + attributeOffset);
+                if (attribute->rta_len < sizeof(rtattr) || attributeOffset + attribute->rta_len > header->nlmsg_len) {
+                    break;
+                }
+                if (attribute->rta_type == TCA_KIND) {
+                    const char* value = reinterpret_cast<const char*>(attribute) + RTA_ALIGN(sizeof(rtattr));
+                    kind.assign(value, strnlen(value, attribute->rta_len - RTA_ALIGN(sizeof(rtattr))));
+                }
+                attributeOffset += RTA_ALIGN(attribute->rta_len);
+            }
+
+            if (message->tcm_parent == TC_H_ROOT) {
+                rootKind = kind;
+            } else if (message->tcm_parent != TC_H_INGRESS) {
+                ++children;
+                if (kind == "fq") {
+                    ++fqChildren;
+                }
+            }
+        }
+    }
+    close(fd);
+    return rootKind == "fq" || (rootKind == "mq" && children > 0 && fqChildren == children);
+}
+#endif
+
+} // namespace
 
 UDPSender::UDPSender(const std::string& address, unsigned short port)
     : socket_(ioContext_, udp::endpoint(udp::v4(), 0)),
@@ -11,6 +157,164 @@ void UDPSender::start() {
     Logger::getInstance().log("UDPSender started.");
 }
 
+void UDPSender::setPacing(const PacingConfig& config) {
+    pacing_ = config;
+    kernelPacing_ = false;
+    pacer_.reset();
+    frameBytes_ = 0;
+    if (!pacing_.enabled) {
+        return;
+    }
+
+    std::uint64_t capBytesPerSecond = pacing_.rateBps / 8;
+    if (pacing_.kernelPacing) {
+#ifdef __linux__
+        // Без подтверждённого fq ядро молча игнорирует скорость, поэтому остаётся корзина токенов
+        unsigned ifindex = egressInterface(endpoint_);
+        if (ifindex != 0 && interfaceUsesFq(ifindex)) {
+            // В режиме кадра скорость выставляется на каждой границе кадра
+            kernelPacing_ = setKernelPacingRate(pacing_.frameMode ? 0 : capBytesPerSecond);
+        } else {
+            Logger::getInstance().log("UDP pacing: egress interface does not use the fq qdisc, kernel pacing unavailable");
+        }
+#endif
+    }
+
+    if (kernelPacing_) {
+        Logger::getInstance().log("UDP pacing: kernel SO_MAX_PACING_RATE on fq qdisc");
+    } else if (pacing_.frameMode && pacing_.targetFPS > 0) {
+        // Скорость задаётся по размеру предыдущего кадра; до первого кадра — только потолок
+        double rate = capBytesPerSecond > 0 ? static_cast<double>(capBytesPerSecond) : 0.0;
+        size_t burst = std::min(pacing_.burstBytes, frameBurstDatagrams_ * kFragmentDatagramSize);
+        pacer_ = std::make_unique<TokenBucketPacer>(rate, burst);
+        Logger::getInstance().log("UDP pacing: token bucket per frame interval, burst " +
+                                  std::to_string(burst) + " bytes");
+    } else if (capBytesPerSecond > 0) {
+        pacer_ = std::make_unique<TokenBucketPacer>(static_cast<double>(capBytesPerSecond), pacing_.burstBytes);
+        Logger::getInstance().log("UDP pacing: token bucket at " + std::to_string(pacing_.rateBps) +
+                                  " bit/s, burst " + std::to_string(pacing_.burstBytes) + " bytes");
+    } else {
+        Logger::getInstance().log("UDP pacing: kernel pacing unavailable and no rateBps set, pacing disabled");
+    }
+}
+
+bool UDPSender::setKernelPacingRate(std::uint64_t bytesPerSecond) {
+#if defined(__linux__) && defined(SO_MAX_PACING_RATE)
+    if (bytesPerSecond == 0) {
+        bytesPerSecond = std::numeric_limits<std::uint32_t>::max();
+    }
+    auto rate = static_cast<std::uint32_t>(std::min<std::uint64_t>(bytesPerSecond, std::numeric_limits<std::uint32_t>::max()));
+    if (setsockopt(socket_.native_handle(), SOL_SOCKET, SO_MAX_PACING_RATE, &rate, sizeof(rate)) != 0) {
+        return false;
+    }
+    kernelRate_ = rate;
+    return true;
+#else
+    (void)bytesPerSecond;
+    return false;
+#endif
+}
+
+std::uint64_t UDPSender::frameRate(std::uint64_t frameBytes) const {
+    std::uint64_t rate = frameBytes * pacing_.targetFPS * 5 / 4;
+    if (pacing_.rateBps > 0) {
+        rate = std::min<std::uint64_t>(rate, pacing_.rateBps / 8);
+    }
+    return rate;
+}
+
 void UDPSender::send(const std::vector<unsigned char>& data) {
-    socket_.send_to(boost::asio::buffer(data), endpoint_);
+    std::chrono::nanoseconds delay{0};
+    TokenBucketPacer* pacer = nullptr;
+    if (pacing_.enabled) {
+        if (kernelPacing_) {
+            // Ядро задерживает датаграмму в очереди fq; оценка — время её выдачи на текущей скорости
+            if (kernelRate_ > 0 && kernelRate_ < std::numeric_limits<std::uint32_t>::max()) {
+                delay = std::chrono::nanoseconds(static_cast<std::int64_t>(data.size() * 1000000000ULL / kernelRate_));
+            }
+        } else {
+            pacer = pacer_.get();
+        }
+    }
+
+    // Корзина разносит во времени только отдельные датаграммы, поэтому с ней пакет
+    // уходит частями не больше MTU; без неё делится только пакет, не влезающий
+    // в одну датаграмму. Получатель собирает части обратно.
+    size_t datagramSize = pacer ? kFragmentDatagramSize : kMaxDatagramSize;
+    if (data.size() > datagramSize) {
+        std::uint32_t packetId = nextPacketId_++;
+        size_t count = fragmentCount(data.size(), datagramSize);
+        for (size_t i = 0; i < count; ++i) {
+            writeFragment(fragment_, data, datagramSize, packetId, i);
+            if (pacer) {
+                delay += pacer->acquire(fragment_.size());
+            }
+            sendDatagram(fragment_);
+        }
+    } else {
+        if (pacer) {
+            delay = pacer->acquire(data.size());
+        }
+        sendDatagram(data);
+    }
+
+    if (pacing_.enabled) {
+        frameBytes_ += data.size();
+        reportPacing(delay);
+    }
+}
+
+void UDPSender::flush() {
+    if (!pacing_.enabled || !pacing_.frameMode || pacing_.targetFPS == 0 || frameBytes_ == 0) {
+        frameBytes_ = 0;
+        return;
+    }
+    // Следующий кадр обычно близок по размеру к только что отправленному
+    std::uint64_t rate = frameRate(frameBytes_);
+    frameBytes_ = 0;
+    if (kernelPacing_) {
+        setKernelPacingRate(rate);
+    } else if (pacer_) {
+        pacer_->setRate(static_cast<double>(rate));
+    }
+}
+
+void UDPSender::sendDatagram(const std::vector<unsigned char>& data) {
+    try {
+        socket_.send_to(boost::asio::buffer(data), endpoint_);
+    } catch (const boost::system::system_error& e) {
+        // Например, нет маршрута — теряем кадр, но не поток отправки
+        Logger::getInstance().log("Error in UDPSender::send: " + std::string(e.what()));
+    }
+}
+
+void UDPSender::reportPacing(std::chrono::nanoseconds delay) {
+    totalDelay_ += delay;
+    maxDelay_ = std::max(maxDelay_, delay);
+    if (++pacedFrames_ < reportInterval_) {
+        return;
+    }
+
+    auto avgUs = std::chrono::duration_cast<std::chrono::microseconds>(totalDelay_).count() /
+                 static_cast<long long>(pacedFrames_);
+    auto maxUs = std::chrono::duration_cast<std::chrono::microseconds>(maxDelay_).count();
+    std::string message = std::string(kernelPacing_ ? "UDP pacing: avg estimated fq delay " : "UDP pacing: avg added delay ") +
+                          std::to_string(avgUs) + " us, max " + std::to_string(maxUs) + " us";
+
+#ifdef __linux__
+    if (kernelPacing_) {
+        // При пейсинге в ядре задержка копится в очереди сокета
+        int queued = 0;
+        if (ioctl(socket_.native_handle(), SIOCOUTQ, &queued) == 0 && kernelRate_ > 0) {
+            auto queueUs = static_cast<std::uint64_t>(queued) * 1000000 / kernelRate_;
+            message += ", socket send queue " + std::to_string(queued) + " bytes (~" +
+                       std::to_string(queueUs) + " us)";
+        }
+    }
+#endif
+    Logger::getInstance().log(message);
+
+    totalDelay_ = std::chrono::nanoseconds(0);
+    maxDelay_ = std::chrono::nanoseconds(0);
+    pacedFrames_ = 0;
 }
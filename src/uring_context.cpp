@@ -0,0 +1,319 @@
+#include "uring_context.hpp"
+#include "logger.hpp"
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace {
+
+constexpr __u64 kRecvTag = 2;
+constexpr __u64 kSendTagBase = 0x100;        // + индекс буфера отправки
+constexpr unsigned kCqeBatch = 64;
+
+} // namespace
+
+bool UringContext::isSupported() {
+    io_uring ring;
+    if (io_uring_queue_init(8, &ring, 0) < 0) {
+        return false;
+    }
+    bool supported = false;
+    io_uring_probe* probe = io_uring_get_probe_ring(&ring);
+    if (probe) {
+        // SEND_ZC появился в том же ядре (6.0), что и multishot recv
+        supported = io_uring_opcode_supported(probe, IORING_OP_SEND_ZC) &&
+                    io_uring_opcode_supported(probe, IORING_OP_RECV);
+        io_uring_free_probe(probe);
+    }
+    io_uring_queue_exit(&ring);
+    return supported;
+}
+
+UringContext::UringContext()
+    : bufferRing_(nullptr),
+      recvArmed_(false),
+      sendBuffersRegistered_(false),
+      preparedSend_(nullptr),
+      pendingResults_(0),
+      sendError_(0) {
+    int ret = io_uring_queue_init(kQueueDepth, &ring_, 0);
+    if (ret < 0) {
+        throw std::system_error(-ret, std::system_category(), "io_uring_queue_init");
+    }
+}
+
+UringContext::~UringContext() {
+    if (bufferRing_) {
+        io_uring_free_buf_ring(&ring_, bufferRing_, kBufferCount, kBufferGroup);
+    }
+    // Закреплённые для SEND_ZC страницы ядро держит само до освобождения skb
+    io_uring_queue_exit(&ring_);
+}
+
+void UringContext::setupBufferRing() {
+    buffers_.resize(static_cast<size_t>(kBufferCount) * kBufferSize);
+
+    int ret = 0;
+    bufferRing_ = io_uring_setup_buf_ring(&ring_, kBufferCount, kBufferGroup, 0, &ret);
+    if (!bufferRing_) {
+        buffers_.clear();
+        throw std::system_error(-ret, std::system_category(), "io_uring_setup_buf_ring");
+    }
+
+    int mask = io_uring_buf_ring_mask(kBufferCount);
+    for (unsigned i = 0; i < kBufferCount; ++i) {
+        io_uring_buf_ring_add(bufferRing_, buffers_.data() + static_cast<size_t>(i) * kBufferSize,
+                              kBufferSize, static_cast<unsigned short>(i), mask, static_cast<int>(i));
+    }
+    io_uring_buf_ring_advance(bufferRing_, static_cast<int>(kBufferCount));
+}
+
+void UringContext::setupSendBuffers() {
+    sendArena_.resize(kSendBufferCount * kSendBufferSize);
+    sendBuffers_.resize(kSendBufferCount);
+
+    std::vector<iovec> iovecs(kSendBufferCount);
+    for (unsigned i = 0; i < kSendBufferCount; ++i) {
+        sendBuffers_[i].data = sendArena_.data() + i * kSendBufferSize;
+        iovecs[i].iov_base = sendBuffers_[i].data;
+        iovecs[i].iov_len = kSendBufferSize;
+    }
+
+    int ret = io_uring_register_buffers(&ring_, iovecs.data(), kSendBufferCount);
+    sendBuffersRegistered_ = ret == 0;
+    if (!sendBuffersRegistered_) {
+        // Обычно упирается в RLIMIT_MEMLOCK; отправка работает и без регистрации
+        Logger::getInstance().log("io_uring_register_buffers failed (" + std::system_category().message(-ret) +
+                                  "), sending from unregistered buffers");
+    }
+}
+
+io_uring_sqe* UringContext::getSqe() {
+    io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+    if (!sqe) {
+        // Очередь заполнена — отдаём накопленное ядру и пробуем снова
+        io_uring_submit(&ring_);
+        sqe = io_uring_get_sqe(&ring_);
+    }
+    if (!sqe) {
+        throw std::system_error(EBUSY, std::system_category(), "io_uring submission queue is full");
+    }
+    return sqe;
+}
+
+UringContext::SendBuffer* UringContext::findFreeSendBuffer() {
+    for (auto& buffer : sendBuffers_) {
+        if (!buffer.busy) {
+            return &buffer;
+        }
+    }
+    return nullptr;
+}
+
+unsigned char* UringContext::prepareSend(size_t size) {
+    if (sendBuffers_.empty()) {
+        setupSendBuffers();
+    }
+    if (preparedSend_) {
+        // Предыдущий буфер так и не поставили в очередь
+        preparedSend_->busy = false;
+        preparedSend_ = nullptr;
+    }
+
+    // Сначала подбираем то, что ядро уже вернуло, без системного вызова
+    reapSendCompletions(false);
+    SendBuffer* buffer = findFreeSendBuffer();
+    while (!buffer) {
+        reapSendCompletions(true);
+        buffer = findFreeSendBuffer();
+    }
+
+    buffer->busy = true;
+    buffer->size = size;
+    if (size > kSendBufferSize) {
+        buffer->overflow.resize(size);
+    } else {
+        buffer->overflow.clear();
+    }
+    preparedSend_ = buffer;
+    return size > kSendBufferSize ? buffer->overflow.data() : buffer->data;
+}
+
+void UringContext::queueSend(int fd, size_t size, size_t zeroCopyThreshold) {
+    SendBuffer* buffer = preparedSend_;
+    if (!buffer || size > buffer->size) {
+        throw std::logic_error("UringContext::queueSend without matching prepareSend");
+    }
+    preparedSend_ = nullptr;
+    buffer->size = size;
+
+    // Связь IOSQE_IO_LINK не переживает границу io_uring_submit, а две отправки
+    // в один поток, одновременно находящиеся у ядра, могут перемешать байты.
+    // Поэтому следующая уходит, когда предыдущая уже легла в буфер сокета.
+    try {
+        waitSends();
+    } catch (...) {
+        buffer->busy = false;
+        throw;
+    }
+
+    auto index = static_cast<unsigned>(buffer - sendBuffers_.data());
+    io_uring_sqe* sqe = getSqe();
+    // MSG_WAITALL: ядро само досылает остаток в потоковый сокет, короткая отправка — ошибка
+    int flags = MSG_NOSIGNAL | MSG_WAITALL;
+    if (size < zeroCopyThreshold) {
+        const unsigned char* data = buffer->overflow.empty() ? buffer->data : buffer->overflow.data();
+        io_uring_prep_send(sqe, fd, data, size, flags);
+    } else if (buffer->overflow.empty() && sendBuffersRegistered_) {
+        io_uring_prep_send_zc_fixed(sqe, fd, buffer->data, size, flags, 0, index);
+    } else {
+        const unsigned char* data = buffer->overflow.empty() ? buffer->data : buffer->overflow.data();
+        io_uring_prep_send_zc(sqe, fd, data, size, flags, 0);
+    }
+    io_uring_sqe_set_data64(sqe, kSendTagBase + index);
+    buffer->awaitingResult = true;
+    ++pendingResults_;
+
+    // Без ожидания: полоса уходит ядру, пока кодируются следующие
+    int ret = io_uring_submit(&ring_);
+    if (ret < 0) {
+        buffer->awaitingResult = false;
+        buffer->busy = false;
+        --pendingResults_;
+        throw std::system_error(-ret, std::system_category(), "io_uring_submit");
+    }
+}
+
+void UringContext::waitSends() {
+    // Результат приходит, как только данные легли в буфер сокета
+    while (pendingResults_ > 0) {
+        reapSendCompletions(true);
+    }
+
+    if (sendError_ != 0) {
+        int err = sendError_;
+        sendError_ = 0;
+        throw std::system_error(err, std::system_category(), "io_uring send");
+    }
+}
+
+void UringContext::reapSendCompletions(bool wait) {
+    if (wait) {
+        io_uring_cqe* cqe = nullptr;
+        int ret = io_uring_wait_cqe(&ring_, &cqe);
+        if (ret < 0 && ret != -EINTR) {
+            throw std::system_error(-ret, std::system_category(), "io_uring_wait_cqe");
+        }
+    }
+
+    io_uring_cqe* cqes[kCqeBatch];
+    unsigned count = io_uring_peek_batch_cqe(&ring_, cqes, kCqeBatch);
+    for (unsigned i = 0; i < count; ++i) {
+        handleSendCompletion(cqes[i]);
+    }
+    io_uring_cq_advance(&ring_, count);
+}
+
+void UringContext::handleSendCompletion(const io_uring_cqe* cqe) {
+    __u64 tag = io_uring_cqe_get_data64(cqe);
+    if (tag < kSendTagBase || tag >= kSendTagBase + sendBuffers_.size()) {
+        return;
+    }
+    SendBuffer& buffer = sendBuffers_[tag - kSendTagBase];
+
+    // Для SEND_ZC ядро присылает два CQE: результат и уведомление о том,
+    // что буфер больше не используется (для TCP — после подтверждения от получателя)
+    if (cqe->flags & IORING_CQE_F_NOTIF) {
+        buffer.awaitingNotification = false;
+    } else {
+        buffer.awaitingResult = false;
+        buffer.awaitingNotification = (cqe->flags & IORING_CQE_F_MORE) != 0;
+        --pendingResults_;
+        if (sendError_ == 0) {
+            if (cqe->res < 0) {
+                sendError_ = -cqe->res;
+            } else if (static_cast<size_t>(cqe->res) < buffer.size) {
+                sendError_ = EIO;
+            }
+        }
+    }
+
+    if (!buffer.awaitingResult && !buffer.awaitingNotification) {
+        buffer.busy = false;
+    }
+}
+
+void UringContext::armMultishotRecv(int fd) {
+    io_uring_sqe* sqe = getSqe();
+    io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = kBufferGroup;
+    io_uring_sqe_set_data64(sqe, kRecvTag);
+    recvArmed_ = true;
+}
+
+void UringContext::recycleBuffer(unsigned short bufferId) {
+    io_uring_buf_ring_add(bufferRing_, buffers_.data() + static_cast<size_t>(bufferId) * kBufferSize,
+                          kBufferSize, bufferId, io_uring_buf_ring_mask(kBufferCount), 0);
+    io_uring_buf_ring_advance(bufferRing_, 1);
+}
+
+bool UringContext::receiveBatch(int fd, std::deque<std::vector<unsigned char>>& out) {
+    if (!bufferRing_) {
+        // Кольцо приёма нужно только получателю, отправитель его не создаёт
+        setupBufferRing();
+    }
+
+    bool open = true;
+    while (out.empty() && open) {
+        if (!recvArmed_) {
+            armMultishotRecv(fd);
+        }
+
+        // Одна системная операция: отправка SQE и ожидание хотя бы одного CQE
+        int ret = io_uring_submit_and_wait(&ring_, 1);
+        if (ret == -EINTR) {
+            continue;
+        }
+        if (ret < 0) {
+            throw std::system_error(-ret, std::system_category(), "io_uring_submit_and_wait");
+        }
+
+        io_uring_cqe* cqes[kCqeBatch];
+        unsigned count = io_uring_peek_batch_cqe(&ring_, cqes, kCqeBatch);
+        for (unsigned i = 0; i < count; ++i) {
+            io_uring_cqe* cqe = cqes[i];
+            if (io_uring_cqe_get_data64(cqe) != kRecvTag) {
+                continue;
+            }
+            if (!(cqe->flags & IORING_CQE_F_MORE)) {
+                recvArmed_ = false;
+            }
+
+            if (cqe->res < 0) {
+                // ENOBUFS — кончились буферы, достаточно перевзвести приём
+                if (cqe->res != -ENOBUFS) {
+                    Logger::getInstance().log("io_uring receive error: " +
+                                              std::system_category().message(-cqe->res));
+                }
+                continue;
+            }
+            if (cqe->res == 0) {
+                open = false;
+            }
+            if (cqe->flags & IORING_CQE_F_BUFFER) {
+                auto bufferId = static_cast<unsigned short>(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+                const unsigned char* buffer = buffers_.data() + static_cast<size_t>(bufferId) * kBufferSize;
+                if (cqe->res > 0) {
+                    out.emplace_back(buffer, buffer + cqe->res);
+                }
+                recycleBuffer(bufferId);
+            }
+        }
+        io_uring_cq_advance(&ring_, count);
+    }
+    return open;
+}
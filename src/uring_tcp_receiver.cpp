@@ -0,0 +1,100 @@
+#include "uring_tcp_receiver.hpp"
+#include "frame_packet.hpp"
+#include "logger.hpp"
+
+using boost::asio::ip::tcp;
+
+UringTCPReceiver::UringTCPReceiver(unsigned short port)
+    : acceptor_(ioContext_, tcp::endpoint(tcp::v4(), port)),
+      socket_(ioContext_),
+      isConnected_(false) {
+    Logger::getInstance().log("UringTCPReceiver initialized on port " + std::to_string(port));
+}
+
+void UringTCPReceiver::start() {
+    Logger::getInstance().log("UringTCPReceiver started.");
+
+    try {
+        Logger::getInstance().log("Waiting for incoming connection...");
+        acceptor_.accept(socket_);
+        isConnected_ = true;
+        Logger::getInstance().log("TCP connection accepted.");
+    } catch (const std::exception& e) {
+        if (stopping_) {
+            return;
+        }
+        Logger::getInstance().log(std::string("UringTCPReceiver start error: ") + e.what());
+    }
+}
+
+std::vector<unsigned char> UringTCPReceiver::receive() {
+    if (stopping_) {
+        return {};
+    }
+    if (!isConnected_) {
+        Logger::getInstance().log("UringTCPReceiver is not connected. Cannot receive data.");
+        return {};
+    }
+
+    // Куски потока из кольца приёма склеиваются, пока не наберётся целый пакет
+    std::vector<unsigned char> packet;
+    while (!nextPacket(packet)) {
+        if (!isConnected_) {
+            return {};
+        }
+        try {
+            if (!uring_.receiveBatch(socket_.native_handle(), pending_)) {
+                Logger::getInstance().log("TCP connection closed by peer.");
+                isConnected_ = false;
+            }
+        } catch (const std::exception& e) {
+            Logger::getInstance().log("TCP receive error: " + std::string(e.what()));
+            return {};
+        }
+        for (const auto& chunk : pending_) {
+            stream_.insert(stream_.end(), chunk.begin(), chunk.end());
+        }
+        pending_.clear();
+    }
+    return packet;
+}
+
+bool UringTCPReceiver::nextPacket(std::vector<unsigned char>& packet) {
+    size_t available = stream_.size() - streamOffset_;
+    if (available < kStreamLengthSize) {
+        return false;
+    }
+    size_t length = readStreamLength(stream_.data() + streamOffset_);
+    if (length > kMaxStreamPacketSize) {
+        // Поток рассинхронизирован, следующие байты уже не разобрать
+        Logger::getInstance().log("TCP packet length " + std::to_string(length) + " is out of range, closing connection.");
+        isConnected_ = false;
+        stream_.clear();
+        streamOffset_ = 0;
+        return false;
+    }
+    if (available < kStreamLengthSize + length) {
+        return false;
+    }
+
+    auto begin = stream_.begin() + static_cast<std::ptrdiff_t>(streamOffset_ + kStreamLengthSize);
+    packet.assign(begin, begin + static_cast<std::ptrdiff_t>(length));
+    streamOffset_ += kStreamLengthSize + length;
+    // Разобранное начало сдвигаем редко, чтобы не копировать хвост на каждом пакете
+    if (streamOffset_ == stream_.size()) {
+        stream_.clear();
+        streamOffset_ = 0;
+    } else if (streamOffset_ > stream_.size() / 2) {
+        stream_.erase(stream_.begin(), stream_.begin() + static_cast<std::ptrdiff_t>(streamOffset_));
+        streamOffset_ = 0;
+    }
+    return true;
+}
+
+void UringTCPReceiver::stop() {
+    stopping_ = true;
+    // Блокирующий accept и ожидание CQE в receiveBatch прерывает только shutdown сокета
+    boost::system::error_code ec;
+    socket_.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+    ::shutdown(acceptor_.native_handle(), SHUT_RDWR);
+}
@@ -0,0 +1,81 @@
+#include "uring_tcp_sender.hpp"
+#include "logger.hpp"
+#include <cstring>
+
+UringTCPSender::UringTCPSender(const std::string& address, unsigned short port)
+    : socket_(ioContext_),
+      endpoint_(boost::asio::ip::make_address(address), port),
+      isConnected_(false) {
+    Logger::getInstance().log("UringTCPSender initialized for " + address + ":" + std::to_string(port));
+}
+
+UringTCPSender::~UringTCPSender() {
+    flush();
+    try {
+        if (socket_.is_open()) {
+            socket_.close();
+            Logger::getInstance().log("TCP socket closed.");
+        }
+    } catch (const std::exception& e) {
+        Logger::getInstance().log("Error closing socket: " + std::string(e.what()));
+    }
+}
+
+void UringTCPSender::start() {
+    try {
+        socket_.connect(endpoint_);
+        isConnected_ = true;
+        Logger::getInstance().log("TCP connection established with " +
+                                   endpoint_.address().to_string() + ":" +
+                                   std::to_string(endpoint_.port()) + " (io_uring)");
+    } catch (const boost::system::system_error& e) {
+        Logger::getInstance().log("TCP connection error: " + std::string(e.what()));
+        throw;
+    }
+}
+
+void UringTCPSender::send(const std::vector<unsigned char>& data) {
+    if (!isConnected_) {
+        return;
+    }
+    try {
+        size_t size = kStreamLengthSize + data.size();
+        unsigned char* buffer = uring_.prepareSend(size);
+        writeStreamLength(buffer, data.size());
+        std::memcpy(buffer + kStreamLengthSize, data.data(), data.size());
+        uring_.queueSend(socket_.native_handle(), size, zeroCopyThreshold_);
+        uring_.waitSends();
+    } catch (const std::system_error& e) {
+        Logger::getInstance().log("Error in UringTCPSender::send: " + std::string(e.what()));
+        isConnected_ = false;
+    }
+}
+
+void UringTCPSender::sendFrame(const std::string& metadata, const std::vector<unsigned char>& payload) {
+    if (!isConnected_) {
+        return;
+    }
+    try {
+        size_t packetSize = framePacketSize(metadata, payload);
+        size_t size = kStreamLengthSize + packetSize;
+        unsigned char* buffer = uring_.prepareSend(size);
+        writeStreamLength(buffer, packetSize);
+        writeFramePacket(buffer + kStreamLengthSize, metadata, payload);
+        uring_.queueSend(socket_.native_handle(), size, zeroCopyThreshold_);
+    } catch (const std::system_error& e) {
+        Logger::getInstance().log("Error in UringTCPSender::sendFrame: " + std::string(e.what()));
+        isConnected_ = false;
+    }
+}
+
+void UringTCPSender::flush() {
+    if (!isConnected_) {
+        return;
+    }
+    try {
+        uring_.waitSends();
+    } catch (const std::system_error& e) {
+        Logger::getInstance().log("Error in UringTCPSender::flush: " + std::string(e.what()));
+        isConnected_ = false;
+    }
+}
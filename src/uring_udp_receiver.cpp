@@ -0,0 +1,41 @@
+#include "uring_udp_receiver.hpp"
+#include "logger.hpp"
+
+using boost::asio::ip::udp;
+
+UringUDPReceiver::UringUDPReceiver(unsigned short port)
+    : socket_(ioContext_, udp::endpoint(udp::v4(), port)) {
+    Logger::getInstance().log("UringUDPReceiver initialized on port " + std::to_string(port));
+}
+
+void UringUDPReceiver::start() {
+    Logger::getInstance().log("UringUDPReceiver started.");
+}
+
+std::vector<unsigned char> UringUDPReceiver::receive() {
+    try {
+        if (pending_.empty()) {
+            // Пустая датаграмма тоже завершает ожидание — результат просто пустой
+            uring_.receiveBatch(socket_.native_handle(), pending_);
+        }
+    } catch (const std::exception& e) {
+        Logger::getInstance().log("Error receiving UDP data: " + std::string(e.what()));
+    }
+
+    // Пока пакет собирается из фрагментов, возвращается пустой результат
+    std::vector<unsigned char> packet;
+    while (!pending_.empty()) {
+        std::vector<unsigned char> datagram = std::move(pending_.front());
+        pending_.pop_front();
+        if (assembler_.add(std::move(datagram), packet)) {
+            return packet;
+        }
+    }
+    return {};
+}
+
+void UringUDPReceiver::stop() {
+    // shutdown будит поток, ждущий датаграмму, даже на неподключённом UDP-сокете
+    boost::system::error_code ec;
+    socket_.shutdown(udp::socket::shutdown_both, ec);
+}
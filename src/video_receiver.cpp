@@ -1,85 +1,365 @@
 #include "video_receiver.hpp"
 #include "logger.hpp"
 #include "metadata.hpp"
+#include "frame_packet.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Целое поле метаданных полосы; значения вне int отклоняются, а не усекаются
+int sliceField(const nlohmann::json& fields, const char* name) {
+    auto value = fields.at(name).get<std::int64_t>();
+    if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+        throw std::out_of_range(std::string(name) + " is out of range");
+    }
+    return static_cast<int>(value);
+}
+
+} // namespace
 
 VideoReceiver::VideoReceiver(ProtocolType protocol, unsigned short port,
                              unsigned short targetFPS,
                              unsigned short videoWidth,
-                             unsigned short videoHeight)
+                             unsigned short videoHeight,
+                             IOBackend backend)
     : protocol_(protocol),
       targetFPS_(targetFPS),
       videoWidth_(videoWidth),
       videoHeight_(videoHeight) {
+    bool useUring = false;
+#ifdef VIDEOSTREAMER_HAS_IO_URING
+    useUring = backend == IOBackend::IoUring;
+#else
+    (void)backend;
+#endif
+
     if (protocol_ == ProtocolType::UDP) {
-        receiver_ = std::make_unique<UDPReceiver>(port);
-        Logger::getInstance().log("VideoReceiver initialized with UDP protocol on port " + std::to_string(port));
+#ifdef VIDEOSTREAMER_HAS_IO_URING
+        if (useUring) {
+            receiver_ = std::make_unique<UringUDPReceiver>(port);
+        }
+#endif
+        if (!receiver_) {
+            receiver_ = std::make_unique<UDPReceiver>(port);
+        }
+        Logger::getInstance().log("VideoReceiver initialized with UDP protocol on port " + std::to_string(port) +
+                                  (useUring ? " (io_uring)" : ""));
     } else if (protocol_ == ProtocolType::TCP) {
-        receiver_ = std::make_unique<TCPReceiver>(port);
-        Logger::getInstance().log("VideoReceiver initialized with TCP protocol on port " + std::to_string(port));
+#ifdef VIDEOSTREAMER_HAS_IO_URING
+        if (useUring) {
+            receiver_ = std::make_unique<UringTCPReceiver>(port);
+        }
+#endif
+        if (!receiver_) {
+            receiver_ = std::make_unique<TCPReceiver>(port);
+        }
+        Logger::getInstance().log("VideoReceiver initialized with TCP protocol on port " + std::to_string(port) +
+                                  (useUring ? " (io_uring)" : ""));
+    } else if (protocol_ == ProtocolType::SHM) {
+#ifdef VIDEOSTREAMER_HAS_SHM
+        receiver_ = std::make_unique<SHMReceiver>(port);
+        Logger::getInstance().log("VideoReceiver initialized with shared memory transport on port " + std::to_string(port));
+#else
+        throw std::runtime_error("Shared memory transport is not supported on this platform");
+#endif
     }
 }
 
 void VideoReceiver::start() {
     Logger::getInstance().log("VideoReceiver started.");
-    stopDisplay = false;
 
     if (protocol_ == ProtocolType::TCP) {
         Logger::getInstance().log("Waiting for TCP connection...");
-        auto* tcpReceiver = dynamic_cast<TCPReceiver*>(receiver_.get());
-        if (tcpReceiver) {
-            tcpReceiver->start(); // Прямой вызов ожидания подключения
-            Logger::getInstance().log("TCP connection established.");
-        } else {
-            Logger::getInstance().log("Error: Receiver is not a TCPReceiver.");
-            return;
-        }
+        receiver_->start(); // Ожидание подключения
+        Logger::getInstance().log("TCP connection established.");
+    } else if (protocol_ == ProtocolType::SHM) {
+        receiver_->start();
     }
 
     Logger::getInstance().log("Starting threads.");
     std::thread receiveThread(&VideoReceiver::receiveFrames, this);
-    std::thread displayThread(&VideoReceiver::displayFrames, this, videoWidth_, videoHeight_, targetFPS_);
+    std::thread displayThread;
+    if (!frameSink_) {
+        displayThread = std::thread(&VideoReceiver::displayFrames, this, videoWidth_, videoHeight_, targetFPS_);
+    }
+
+    if (threading_.statsIntervalSec > 0) {
+        threadStats_.runReporter(stopDisplay, std::chrono::seconds(threading_.statsIntervalSec));
+    }
 
     receiveThread.join();
-    displayThread.join();
+    if (displayThread.joinable()) {
+        displayThread.join();
+    }
+    threadStats_.report();
+}
+
+void VideoReceiver::stop() {
+    stopDisplay = true;
+    frameCondVar.notify_all();
+    receiver_->stop();
+}
+
+void VideoReceiver::setFrameSink(FrameSink sink) {
+    frameSink_ = std::move(sink);
+}
+
+void VideoReceiver::setSliceThreads(unsigned threads) {
+    sliceThreads_ = threads;
+}
+
+void VideoReceiver::setThreadingConfig(const ThreadingConfig& config) {
+    threading_ = config;
 }
 
 
 void VideoReceiver::receiveFrames() {
-    while (!stopDisplay) {
-        std::vector<unsigned char> data = receiver_->receive();
+    ThreadScope threadScope(threadStats_, "receive", threading_.get("receive"));
+#ifdef VIDEOSTREAMER_HAS_SHM
+    auto* shmReceiver = dynamic_cast<SHMReceiver*>(receiver_.get());
+#endif
 
-        if (!data.empty()) {
-            auto separatorPos = std::find(data.begin(), data.end(), 0);
-            if (separatorPos == data.end()) {
-                Logger::getInstance().log("Error: No metadata separator found!");
+    while (!stopDisplay) {
+        cv::Mat frame;
+        std::shared_ptr<SliceJob> slice;
+        FrameInfo info;
+#ifdef VIDEOSTREAMER_HAS_SHM
+        if (shmReceiver) {
+            // Декодируем прямо из слота разделяемой памяти, без промежуточных копий
+            size_t size = 0;
+            const unsigned char* data = shmReceiver->acquire(size);
+            if (!data) {
                 continue;
             }
-
-            std::vector<unsigned char> metadataBytes(data.begin(), separatorPos);
-            MetaData metaData;
-            metaData.parse(metadataBytes);
-            if (!metaData.isValid()) {
+            frame = decodePacket(data, size, slice, info);
+            if (!shmReceiver->release()) {
                 continue;
             }
+        } else
+#endif
+        {
+            std::vector<unsigned char> data = receiver_->receive();
+            if (data.empty()) {
+                continue;
+            }
+            frame = decodePacket(data.data(), data.size(), slice, info);
+        }
 
-            std::vector<unsigned char> frameData(separatorPos + 1, data.end());
-            cv::Mat frame = cv::imdecode(frameData, cv::IMREAD_COLOR);
-            if (!frame.empty()) {
-                {
-                    std::lock_guard<std::mutex> lock(queueMutex);
-                    if (frameQueue.size() < maxQueueSize) {
-                        frameQueue.push(frame);
-                    } else {
-                        Logger::getInstance().log("Frame queue is full. Dropping frame.");
-                    }
+        if (slice) {
+            dispatchSlice(slice);
+        } else if (!frame.empty()) {
+            deliverFrame(frame, info);
+        }
+    }
+}
+
+cv::Mat VideoReceiver::decodePacket(const unsigned char* data, size_t size, std::shared_ptr<SliceJob>& slice,
+                                    FrameInfo& info) {
+    MetaData metaData;
+    const unsigned char* payload = nullptr;
+    size_t payloadSize = 0;
+    if (!parseFramePacket(data, size, metaData, payload, payloadSize)) {
+        return {};
+    }
+
+    const nlohmann::json& fields = metaData.get();
+    info.timestampUs = fields.value("timestamp", std::int64_t{0});
+    info.encodedBytes = payloadSize;
+    if (fields.contains("slice_count")) {
+        // Полоса декодируется в пуле, поэтому сжатые данные копируются из буфера приёма
+        try {
+            slice = std::make_shared<SliceJob>(SliceJob{
+                fields.value("stream_id", std::uint64_t{0}),
+                fields.at("frame_id").get<std::uint64_t>(),
+                sliceField(fields, "slice_index"),
+                sliceField(fields, "slice_count"),
+                sliceField(fields, "slice_y"),
+                sliceField(fields, "slice_height"),
+                sliceField(fields, "frame_width"),
+                sliceField(fields, "frame_height"),
+                info.timestampUs,
+                std::vector<unsigned char>(payload, payload + payloadSize)});
+        } catch (const std::exception& e) {
+            Logger::getInstance().log(std::string("Error: Invalid slice metadata: ") + e.what());
+            slice.reset();
+        }
+        return {};
+    }
+
+    // Заголовок cv::Mat поверх исходного буфера — без копирования сжатых данных
+    cv::Mat frameData(1, static_cast<int>(payloadSize), CV_8UC1, const_cast<unsigned char*>(payload));
+    return cv::imdecode(frameData, cv::IMREAD_COLOR);
+}
+
+void VideoReceiver::dispatchSlice(const std::shared_ptr<SliceJob>& job) {
+    // Геометрия приходит из сети: сравнения в 64 битах, чтобы y + height не переполнился
+    if (job->frameWidth <= 0 || job->frameWidth > maxFrameDimension ||
+        job->frameHeight <= 0 || job->frameHeight > maxFrameDimension ||
+        job->count <= 0 || job->count > job->frameHeight || job->index < 0 || job->index >= job->count ||
+        job->y < 0 || job->height <= 0 ||
+        static_cast<std::int64_t>(job->y) + job->height > job->frameHeight) {
+        Logger::getInstance().log("Error: Slice geometry is out of range, dropping slice.");
+        return;
+    }
+    if (!decodePool_) {
+        decodePool_ = std::make_unique<StagePool>(threadStats_, "decode", threading_.get("decode"), sliceThreads_);
+    }
+
+    std::shared_ptr<SliceFrame> frame;
+    std::vector<std::shared_ptr<SliceFrame>> ready;
+    {
+        std::lock_guard<std::mutex> lock(sliceMutex_);
+        if (job->streamId != sliceStreamId_) {
+            // Отправитель перезапущен и считает кадры заново: иначе все его полосы
+            // считались бы опоздавшими. Недособранные кадры старого потока бросаем,
+            // их задачи в пуле доработают вхолостую.
+            if (hasSliceFrame_ || !sliceFrames_.empty()) {
+                Logger::getInstance().log("Slice stream restarted by sender, resetting frame assembly.");
+            }
+            sliceFrames_.clear();
+            sliceStreamId_ = job->streamId;
+            hasSliceFrame_ = false;
+            lastSliceFrameId_ = 0;
+        }
+        if (hasSliceFrame_ && job->frameId <= lastSliceFrameId_) {
+            return; // Полоса опоздала — кадр уже показан
+        }
+
+        auto it = sliceFrames_.find(job->frameId);
+        if (it == sliceFrames_.end()) {
+            try {
+                frame = std::make_shared<SliceFrame>();
+                frame->streamId = job->streamId;
+                frame->id = job->frameId;
+                frame->info.timestampUs = job->timestampUs;
+                frame->image.create(job->frameHeight, job->frameWidth, CV_8UC3);
+                frame->filled.assign(static_cast<size_t>(job->count), false);
+            } catch (const std::exception& e) {
+                // Исключение в потоке приёма завершило бы процесс
+                Logger::getInstance().log(std::string("Error: Failed to allocate slice frame: ") + e.what());
+                return;
+            }
+            sliceFrames_.emplace(job->frameId, frame);
+
+            // Начался новый кадр: более старые закрываем, потерянные полосы уже не придут
+            for (auto older = sliceFrames_.begin(); older != sliceFrames_.end() && older->first < job->frameId;) {
+                older->second->closed = true;
+                if (older->second->inFlight == 0) {
+                    ready.push_back(older->second);
+                    older = sliceFrames_.erase(older);
+                } else {
+                    ++older;
                 }
-                frameCondVar.notify_one();
             }
+        } else {
+            frame = it->second;
+        }
+
+        if (frame->image.cols != job->frameWidth || frame->image.rows != job->frameHeight ||
+            frame->filled.size() != static_cast<size_t>(job->count)) {
+            Logger::getInstance().log("Error: Slice does not match frame geometry, dropping slice.");
+            frame.reset();
+        } else {
+            ++frame->inFlight;
+            frame->info.encodedBytes += job->data.size();
+        }
+    }
+
+    for (const auto& readyFrame : ready) {
+        emitSliceFrame(readyFrame);
+    }
+    if (frame) {
+        decodePool_->post([this, frame, job]() { decodeSlice(frame, job); });
+    }
+}
+
+void VideoReceiver::decodeSlice(const std::shared_ptr<SliceFrame>& frame, const std::shared_ptr<SliceJob>& job) {
+    // Декодирование прямо в полосу выходного кадра: imdecode не перевыделяет
+    // память, если размер и тип совпадают
+    cv::Mat band = frame->image.rowRange(job->y, job->y + job->height);
+    cv::Mat decoded = band;
+    cv::Mat sliceData(1, static_cast<int>(job->data.size()), CV_8UC1, job->data.data());
+    bool ok = !job->data.empty();
+    if (ok) {
+        // Исключение из задачи пула завершает процесс, поэтому испорченная полоса просто теряется
+        try {
+            cv::imdecode(sliceData, cv::IMREAD_COLOR, &decoded);
+            ok = !decoded.empty() && decoded.size() == band.size() && decoded.type() == band.type();
+            if (ok && decoded.data != band.data) {
+                decoded.copyTo(band);
+            }
+        } catch (const std::exception& e) {
+            Logger::getInstance().log(std::string("Error: Failed to decode slice: ") + e.what());
+            ok = false;
+        }
+    }
+
+    bool complete = false;
+    {
+        std::lock_guard<std::mutex> lock(sliceMutex_);
+        --frame->inFlight;
+        if (ok && !frame->filled[static_cast<size_t>(job->index)]) {
+            frame->filled[static_cast<size_t>(job->index)] = true;
+            ++frame->decoded;
+        }
+        if (frame->decoded == static_cast<int>(frame->filled.size()) || (frame->closed && frame->inFlight == 0)) {
+            // Под тем же номером может уже собираться кадр нового потока
+            auto it = sliceFrames_.find(frame->id);
+            if (it != sliceFrames_.end() && it->second == frame) {
+                sliceFrames_.erase(it);
+                complete = true;
+            }
+        }
+    }
+    if (complete) {
+        emitSliceFrame(frame);
+    }
+}
+
+void VideoReceiver::emitSliceFrame(const std::shared_ptr<SliceFrame>& frame) {
+    {
+        std::lock_guard<std::mutex> lock(sliceMutex_);
+        if (frame->streamId != sliceStreamId_ || (hasSliceFrame_ && frame->id <= lastSliceFrameId_)) {
+            return;
+        }
+        hasSliceFrame_ = true;
+        lastSliceFrameId_ = frame->id;
+    }
+
+    // Потерянные полосы портят только свою область кадра
+    const int rows = frame->image.rows;
+    const int count = static_cast<int>(frame->filled.size());
+    for (int index = 0; index < count; ++index) {
+        if (!frame->filled[static_cast<size_t>(index)]) {
+            frame->image.rowRange(rows * index / count, rows * (index + 1) / count).setTo(cv::Scalar::all(0));
+        }
+    }
+    deliverFrame(frame->image, frame->info);
+}
+
+void VideoReceiver::deliverFrame(const cv::Mat& frame, const FrameInfo& info) {
+    if (frameSink_) {
+        frameSink_(frame, info);
+    } else {
+        enqueueFrame(frame);
+    }
+}
+
+void VideoReceiver::enqueueFrame(const cv::Mat& frame) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (frameQueue.size() < maxQueueSize) {
+            frameQueue.push(frame);
+        } else {
+            Logger::getInstance().log("Frame queue is full. Dropping frame.");
         }
     }
+    frameCondVar.notify_one();
 }
 
 void VideoReceiver::displayFrames(int videoWidth, int videoHeight, int targetFPS) {
+    ThreadScope threadScope(threadStats_, "display", threading_.get("display"));
     cv::namedWindow("VideoReceiver", cv::WINDOW_NORMAL);
     cv::resizeWindow("VideoReceiver", videoWidth, videoHeight);
 
@@ -1,15 +1,45 @@
 #include "video_sender.hpp"
 #include "metadata.hpp"
+#include <algorithm>
+#include <future>
+#include <random>
 
 using json = nlohmann::json;
 
+namespace {
+
+std::int64_t currentTimeUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 VideoSender::VideoSender(const std::string& address, unsigned short port,
-                         unsigned short cameraIndex, ProtocolType protocol)
-    : address_(address), port_(port), cameraIndex_(cameraIndex), protocol_(protocol) {
+                         unsigned short cameraIndex, ProtocolType protocol,
+                         IOBackend backend)
+    : address_(address), port_(port), cameraIndex_(cameraIndex), protocol_(protocol),
+      streamId_(std::random_device{}()) {
+#ifndef VIDEOSTREAMER_HAS_IO_URING
+    (void)backend;
+#endif
     if (protocol_ == ProtocolType::TCP) {
-        sender_ = std::make_unique<TCPSender>(address, port);
+#ifdef VIDEOSTREAMER_HAS_IO_URING
+        if (backend == IOBackend::IoUring) {
+            sender_ = std::make_unique<UringTCPSender>(address, port);
+        }
+#endif
+        if (!sender_) {
+            sender_ = std::make_unique<TCPSender>(address, port);
+        }
     } else if (protocol_ == ProtocolType::UDP) {
         sender_ = std::make_unique<UDPSender>(address, port);
+    } else if (protocol_ == ProtocolType::SHM) {
+#ifdef VIDEOSTREAMER_HAS_SHM
+        sender_ = std::make_unique<SHMSender>(port);
+#else
+        throw std::runtime_error("Shared memory transport is not supported on this platform");
+#endif
     }
 }
 
@@ -20,49 +50,69 @@ void VideoSender::start() {
 
     if (protocol_ == ProtocolType::TCP) {
         Logger::getInstance().log("Establishing TCP connection...");
-        auto *tcpSender = dynamic_cast<TCPSender *>(sender_.get());
-        if (tcpSender) {
-          tcpSender->start();
-          Logger::getInstance().log("TCP connection established. Starting threads.");
-        } else {
-          Logger::getInstance().log("Error: Receiver is not a TCPReceiver");
-        }
-        
+        sender_->start();
+        Logger::getInstance().log("TCP connection established. Starting threads.");
+    } else if (protocol_ == ProtocolType::SHM) {
+        sender_->start();
     }
 
     std::thread captureThread(&VideoSender::captureFrame, this);
     std::thread sendThread(&VideoSender::sendFrame, this);
 
+    if (threading_.statsIntervalSec > 0) {
+        threadStats_.runReporter(stopFlag, std::chrono::seconds(threading_.statsIntervalSec));
+    }
+
     captureThread.join();
     sendThread.join();
+    threadStats_.report();
+}
+
+void VideoSender::setThreadingConfig(const ThreadingConfig& config) {
+    threading_ = config;
+}
+
+void VideoSender::setPacing(const PacingConfig& config) {
+    auto *udpSender = dynamic_cast<UDPSender *>(sender_.get());
+    if (udpSender) {
+        udpSender->setPacing(config);
+    } else if (config.enabled) {
+        Logger::getInstance().log("Pacing is only supported for UDP, ignoring pacing settings");
+    }
 }
 
 
 void VideoSender::captureFrame() {
-    cv::VideoCapture cap(cameraIndex_); // Открываем камеру
+    ThreadScope threadScope(threadStats_, "capture", threading_.get("capture"));
+    cv::VideoCapture cap;
 
-    if (!cap.isOpened()) {
-        Logger::getInstance().log("Failed to open camera");
-        stopFlag = true;
-        return;
+    if (!frameSource_) {
+        cap.open(cameraIndex_); // Открываем камеру
+        if (!cap.isOpened()) {
+            Logger::getInstance().log("Failed to open camera");
+            stopFlag = true;
+            frameCondVar_.notify_all();
+            return;
+        }
+        Logger::getInstance().log("Camera opened");
     }
 
-    Logger::getInstance().log("Camera opened");
-
     while (!stopFlag) {
         cv::Mat frame;
 
-        if (!cap.read(frame)) {
-            Logger::getInstance().log("Failed to read frame from camera");
+        bool captured = frameSource_ ? frameSource_(frame) : cap.read(frame);
+        if (!captured) {
+            Logger::getInstance().log(frameSource_ ? "Frame source exhausted" : "Failed to read frame from camera");
             stopFlag = true;
+            frameCondVar_.notify_all();
             break;
         }
 
-        auto framePtr = std::make_shared<cv::Mat>(std::move(frame));
+        CapturedFrame capturedFrame{std::make_shared<cv::Mat>(std::move(frame)), currentTimeUs()};
         {
             std::lock_guard<std::mutex> lock(frameQueueMutex_);
             if (frameQueue_.size() < maxQueueSize_) {
-                frameQueue_.push(framePtr);
+                frameQueue_.push(std::move(capturedFrame));
                 frameCondVar_.notify_one();
             }
         }
@@ -75,8 +125,10 @@ void VideoSender::captureFrame() {
 
 
 void VideoSender::sendFrame() {
-    while (!stopFlag) {
-        std::shared_ptr<cv::Mat> frameToSend;
+    ThreadScope threadScope(threadStats_, "send", threading_.get("send"));
+    // После остановки досылаем то, что уже лежит в очереди
+    while (true) {
+        CapturedFrame frameToSend;
 
         {
             std::unique_lock<std::mutex> lock(frameQueueMutex_);
@@ -84,39 +136,105 @@ void VideoSender::sendFrame() {
 
             if (stopFlag && frameQueue_.empty()) break;
 
-            frameToSend = frameQueue_.front();
+            frameToSend = std::move(frameQueue_.front());
             frameQueue_.pop();
         }
 
-        if (frameToSend) {
-            std::vector<unsigned char> encodedBuffer;
-            if (!cv::imencode(".jpg", *frameToSend, encodedBuffer, compression_params_)) {
-                Logger::getInstance().log("Error: Failed to compress the image!");
-                continue;
-            }
-
-            MetaData metaData;
-            metaData.create(
-                nlohmann::json{
-                {"frame_size", encodedBuffer.size()},
-                {"timestamp", 1234567890}
+        if (!frameToSend.image) {
+            continue;
+        }
+        if (sliceCount_ > 1) {
+            sendSlices(frameToSend.image, frameToSend.timestampUs);
+        } else {
+            encodeAndSend(*frameToSend.image, nlohmann::json{
+                {"timestamp", frameToSend.timestampUs}
                 });
+        }
+        std::lock_guard<std::mutex> lock(sendMutex_);
+        sender_->flush();
+    }
+}
 
-            if (!metaData.isValid()) {
-                Logger::getInstance().log("Error: Failed to create metadata!");
-                continue;
-            }
+void VideoSender::encodeAndSend(const cv::Mat& image, const nlohmann::json& metadata) {
+    std::vector<unsigned char> encodedBuffer;
+    if (!cv::imencode(".jpg", image, encodedBuffer, compression_params_)) {
+        Logger::getInstance().log("Error: Failed to compress the image!");
+        return;
+    }
 
-            std::string metadataStr = metaData.get().dump();
+    MetaData metaData;
+    nlohmann::json fields = metadata;
+    fields["frame_size"] = encodedBuffer.size();
+    metaData.create(fields);
 
-            std::vector<unsigned char> dataToSend(metadataStr.begin(), metadataStr.end());
-            dataToSend.push_back(0);
-            dataToSend.insert(dataToSend.end(), encodedBuffer.begin(), encodedBuffer.end());
+    if (!metaData.isValid()) {
+        Logger::getInstance().log("Error: Failed to create metadata!");
+        return;
+    }
 
-            // Отправка данных
-            sender_->send(dataToSend);
-        }
+    std::string metadataText = metaData.get().dump();
+
+    // Отправка данных
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    sender_->sendFrame(metadataText, encodedBuffer);
+}
+
+void VideoSender::sendSlices(const std::shared_ptr<cv::Mat>& frame, std::int64_t timestampUs) {
+    const int rows = frame->rows;
+    const int count = std::min(static_cast<int>(sliceCount_), rows);
+    const std::uint64_t frameId = frameId_++;
+    if (!encodePool_) {
+        encodePool_ = std::make_unique<StagePool>(threadStats_, "encode", threading_.get("encode"), sliceThreads_);
     }
+
+    std::vector<std::future<void>> pending;
+    pending.reserve(static_cast<size_t>(count));
+    for (int index = 0; index < count; ++index) {
+        // Каждая полоса — самостоятельный JPEG и уходит сразу после кодирования
+        int y = rows * index / count;
+        int height = rows * (index + 1) / count - y;
+        auto task = std::make_shared<std::packaged_task<void()>>([this, frame, timestampUs, frameId, index, count, y, height]() {
+            cv::Mat strip = frame->rowRange(y, y + height);
+            encodeAndSend(strip, nlohmann::json{
+                {"timestamp", timestampUs},
+                {"stream_id", streamId_},
+                {"frame_id", frameId},
+                {"slice_index", index},
+                {"slice_count", count},
+                {"slice_y", y},
+                {"slice_height", height},
+                {"frame_width", frame->cols},
+                {"frame_height", rows}
+                });
+        });
+        pending.push_back(task->get_future());
+        encodePool_->post([task]() { (*task)(); });
+    }
+
+    for (auto& done : pending) {
+        done.wait();
+    }
+}
+
+void VideoSender::setSlicing(unsigned slices, unsigned threads) {
+    sliceCount_ = std::max(slices, 1u);
+    sliceThreads_ = threads;
+    encodePool_.reset();
+    if (sliceCount_ > 1) {
+        Logger::getInstance().log("Slice encoding: " + std::to_string(sliceCount_) + " strips per frame");
+    }
+}
+
+void VideoSender::setFrameSource(FrameSource source) {
+    frameSource_ = std::move(source);
+}
+
+void VideoSender::setJpegQuality(int quality) {
+    compression_params_ = {cv::IMWRITE_JPEG_QUALITY, std::clamp(quality, 0, 100)};
+}
+
+void VideoSender::setMaxQueueSize(size_t size) {
+    maxQueueSize_ = std::max<size_t>(size, 1);
 }
 
 void VideoSender::stop() {